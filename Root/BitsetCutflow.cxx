@@ -7,9 +7,8 @@ BitsetCutflow::BitsetCutflow(EL::Worker *wk){
   m_wk = wk;
   m_cutflowHist = new TH1I("cutflow_hist","Cutflow",99,-0.5,98.5);
   m_wk->addOutput(m_cutflowHist);
-  m_cutflowStepCounter = 1;
-  m_cutflowHist->GetXaxis()->SetBinLabel(m_cutflowStepCounter,"All");
-  m_cutflowHist->Fill(0.0,-1.0); /// to compensate for the first event false filling
+  m_cutflowHist->GetXaxis()->SetBinLabel(1,"All");
+  m_numEvents = 0;
 }
 
 BitsetCutflow::~BitsetCutflow(){
@@ -17,39 +16,47 @@ BitsetCutflow::~BitsetCutflow(){
 }
 
 void BitsetCutflow::PushBitSet(){
-  
-  /// First bin: All events
-  m_cutflowHist->Fill(0);
-  
-  /// first and second bits will be always 0
-  for (unsigned i=1; i<=m_mapCutflowSteps.size(); i++){
-    /// first bit is always zero
-    if (m_bitset[i+1]!=m_bitset[0]) m_cutflowHist->Fill(i); 
-  }
-  
-  /// clean bit for next event
-  m_bitset.reset();
+  /// the steps filled from here on belong to the next event
+  m_numEvents++;
 }
 
-void BitsetCutflow::FillCutflow(string cutflowStepName, bool fillCutflow){
-  /// check if there is a slot already created for this cutflow step
-  if (fillCutflow){
-    unsigned int slotPosition = m_mapCutflowSteps[cutflowStepName];
-    if (slotPosition==0){
-      m_cutflowStepCounter++;
-      m_mapCutflowSteps[cutflowStepName] = m_cutflowStepCounter;
-      slotPosition = m_cutflowStepCounter;
-      m_cutflowHist->GetXaxis()->SetBinLabel(m_cutflowStepCounter,cutflowStepName.c_str());
-    }
-    m_bitset[slotPosition]=1;
+unsigned int BitsetCutflow::RegisterStep(const string& cutflowStepName){
+  map<string,unsigned int>::const_iterator it = m_mapCutflowSteps.find(cutflowStepName);
+  if (it != m_mapCutflowSteps.end()) return it->second;
+  const unsigned int step = m_stepNames.size();
+  m_mapCutflowSteps[cutflowStepName] = step;
+  m_stepNames.push_back(cutflowStepName);
+  m_stepCounts.push_back(0);
+  m_stepEvent.push_back(~0ULL);
+  return step;
+}
+
+void BitsetCutflow::FillCutflow(const string& cutflowStepName, bool fillCutflow){
+  if (fillCutflow) Fill(RegisterStep(cutflowStepName));
+}
+
+void BitsetCutflow::Flush(){
+  /// at least the historical 99 bins, so that the outputs of all workers merge
+  int nBins = m_stepNames.size() + 1;
+  if (nBins < 99) nBins = 99;
+  m_cutflowHist->SetBins(nBins, -0.5, nBins - 0.5);
+  m_cutflowHist->Reset();
+
+  /// First bin: All events (the first PushBitSet() starts the first event)
+  const unsigned long long numEvents = m_numEvents > 0 ? m_numEvents - 1 : 0;
+  m_cutflowHist->GetXaxis()->SetBinLabel(1,"All");
+  m_cutflowHist->SetBinContent(1, numEvents);
+  for (unsigned int i = 0; i < m_stepNames.size(); i++) {
+    m_cutflowHist->GetXaxis()->SetBinLabel(i+2, m_stepNames[i].c_str());
+    m_cutflowHist->SetBinContent(i+2, m_stepCounts[i]);
   }
+  m_cutflowHist->SetEntries(numEvents);
 }
 
 void BitsetCutflow::PrintCutflowLocally(){
-  for (int i=1; i<=m_cutflowHist->GetNbinsX(); i++){
-    int binContent = m_cutflowHist->GetBinContent(i);
-    if (binContent<=0) break;
-    string binLabel = m_cutflowHist->GetXaxis()->GetBinLabel(i);
-    cout << binLabel << ":\t" << binContent << endl;
+  const unsigned long long numEvents = m_numEvents > 0 ? m_numEvents - 1 : 0;
+  cout << "All:\t" << numEvents << endl;
+  for (unsigned int i = 0; i < m_stepNames.size(); i++){
+    cout << m_stepNames[i] << ":\t" << m_stepCounts[i] << endl;
   }
 }
@@ -0,0 +1,70 @@
+#include <ZinvAnalysis/CutChain.h>
+
+#include <TError.h>
+#include <algorithm>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(CutChain)
+
+CutChain::CutChain(const std::string& name){
+  m_name = name;
+  m_adaptive = true;
+  m_reordered = false;
+  m_numWarmUp = 1000;
+  m_timingPrescale = 64;
+  m_numEvaluations = 0;
+}
+
+CutChain::~CutChain(){
+
+}
+
+unsigned int CutChain::AddCut(unsigned int stage, const std::string& name){
+  const unsigned int id = m_cutName.size();
+  m_cutName.push_back(name);
+  m_cutStage.push_back(stage);
+  if (stage >= m_stageOrder.size()) m_stageOrder.resize(stage + 1);
+  m_stageOrder[stage].push_back(id);
+  m_numCalls.push_back(0);
+  m_numPass.push_back(0);
+  m_numTimed.push_back(0);
+  m_time.push_back(0.);
+  return id;
+}
+
+void CutChain::SetWarmUp(long long numWarmUp, unsigned int timingPrescale){
+  m_numWarmUp = numWarmUp;
+  m_timingPrescale = timingPrescale > 0 ? timingPrescale : 1;
+}
+
+void CutChain::Reorder(){
+  // expected cost of a cut per rejected object; cuts that never reject go last
+  std::vector<double> score(m_cutName.size(), 0.);
+  for (unsigned int id = 0; id < m_cutName.size(); id++) {
+    const double cost = m_numTimed[id] > 0 ? m_time[id] / m_numTimed[id] : 0.;
+    const double rejection = m_numCalls[id] > 0 ? 1. - double(m_numPass[id]) / m_numCalls[id] : 0.;
+    score[id] = rejection > 0. ? cost / rejection : 1e30;
+  }
+
+  for (unsigned int s = 0; s < m_stageOrder.size(); s++) {
+    std::stable_sort(m_stageOrder[s].begin(), m_stageOrder[s].end(),
+        [&score](unsigned int a, unsigned int b) { return score[a] < score[b]; });
+  }
+
+  m_reordered = true;
+  Report();
+}
+
+void CutChain::Report() const {
+  ::Info("CutChain", "%s cut chain (%s, %lld stage evaluations):", m_name.c_str(),
+      m_reordered ? "reordered" : "declared order", m_numEvaluations);
+  for (unsigned int s = 0; s < m_stageOrder.size(); s++) {
+    for (unsigned int k = 0; k < m_stageOrder[s].size(); k++) {
+      const unsigned int id = m_stageOrder[s][k];
+      const double cost = m_numTimed[id] > 0 ? 1e9 * m_time[id] / m_numTimed[id] : 0.;
+      const double eff = m_numCalls[id] > 0 ? double(m_numPass[id]) / m_numCalls[id] : 0.;
+      ::Info("CutChain", "  stage %u %-16s calls %10lld  efficiency %.4f  %8.1f ns/call",
+          s, m_cutName[id].c_str(), m_numCalls[id], eff, cost);
+    }
+  }
+}
@@ -0,0 +1,67 @@
+#include <ZinvAnalysis/DecisionCache.h>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(DecisionCache)
+
+namespace {
+
+  const char* decisionName[kNumObjectDecisions] = {
+    "MuonLoose", "ElectronOQ", "ElectronLH", "Tau", "JetCleanLoose", "JetCleanTight", "BTag"
+  };
+
+}
+
+DecisionCache::DecisionCache(){
+  for (unsigned int d = 0; d < kNumObjectDecisions; d++) {
+    m_rule[d] = kRuleAlways;
+    m_threshold[d] = 0.;
+    m_numHits[d] = 0;
+    m_numMisses[d] = 0;
+  }
+}
+
+DecisionCache::~DecisionCache(){
+
+}
+
+void DecisionCache::SetRule(unsigned int decision, DecisionRule rule, float threshold){
+  m_rule[decision] = rule;
+  m_threshold[decision] = threshold;
+}
+
+void DecisionCache::Clear(){
+  for (unsigned int d = 0; d < kNumObjectDecisions; d++) {
+    m_state[d].clear();
+    m_key[d].clear();
+  }
+}
+
+int DecisionCache::Get(unsigned int decision, unsigned int index, float key){
+  const std::vector<char> &state = m_state[decision];
+  bool valid = index < state.size() && state[index] >= 0;
+  if (valid) {
+    const float cachedKey = m_key[decision][index];
+    if (m_rule[decision] == kRuleSameKey) valid = key == cachedKey;
+    else if (m_rule[decision] == kRuleSameSide) valid = (key > m_threshold[decision]) == (cachedKey > m_threshold[decision]);
+  }
+  if (!valid) {
+    m_numMisses[decision]++;
+    return -1;
+  }
+  m_numHits[decision]++;
+  return state[index];
+}
+
+void DecisionCache::Set(unsigned int decision, unsigned int index, float key, bool accept){
+  std::vector<char> &state = m_state[decision];
+  if (index >= state.size()) {
+    state.resize(index + 1, -1);
+    m_key[decision].resize(index + 1, 0.);
+  }
+  state[index] = accept;
+  m_key[decision][index] = key;
+}
+
+const char* DecisionCache::Name(unsigned int decision){
+  return decision < kNumObjectDecisions ? decisionName[decision] : "";
+}
@@ -0,0 +1,118 @@
+#include <ZinvAnalysis/DeltaKernels.h>
+
+#include <TMath.h>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+  const float kPi = TMath::Pi();
+  const float kTwoPi = TMath::TwoPi();
+
+  inline float scalarDeltaPhi(float phi1, float phi2) {
+    float dPhi = std::fabs(phi1 - phi2);
+    if (dPhi > kPi) dPhi = kTwoPi - dPhi;
+    return dPhi;
+  }
+
+#if defined(__AVX__)
+  const unsigned int kWidth = 8;
+
+  inline __m256 vecDeltaPhi(__m256 phi1, __m256 phi2) {
+    const __m256 signMask = _mm256_set1_ps(-0.f);
+    __m256 dPhi = _mm256_andnot_ps(signMask, _mm256_sub_ps(phi1, phi2));
+    __m256 wrap = _mm256_cmp_ps(dPhi, _mm256_set1_ps(kPi), _CMP_GT_OQ);
+    return _mm256_blendv_ps(dPhi, _mm256_sub_ps(_mm256_set1_ps(kTwoPi), dPhi), wrap);
+  }
+
+  inline __m256 vecDeltaR(__m256 eta1, __m256 eta2, __m256 phi1, __m256 phi2) {
+    __m256 dEta = _mm256_sub_ps(eta1, eta2);
+    __m256 dPhi = vecDeltaPhi(phi1, phi2);
+    return _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dEta, dEta), _mm256_mul_ps(dPhi, dPhi)));
+  }
+
+  inline void vecDeltaPhiStore(float* out, float phiRef, const float* phi) {
+    _mm256_storeu_ps(out, vecDeltaPhi(_mm256_loadu_ps(phi), _mm256_set1_ps(phiRef)));
+  }
+
+  inline void vecDeltaRStore(float* out, float etaRef, float phiRef, const float* eta, const float* phi) {
+    _mm256_storeu_ps(out, vecDeltaR(_mm256_loadu_ps(eta), _mm256_set1_ps(etaRef),
+          _mm256_loadu_ps(phi), _mm256_set1_ps(phiRef)));
+  }
+#elif defined(__SSE2__)
+  const unsigned int kWidth = 4;
+
+  inline __m128 vecDeltaPhi(__m128 phi1, __m128 phi2) {
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    __m128 dPhi = _mm_andnot_ps(signMask, _mm_sub_ps(phi1, phi2));
+    __m128 wrap = _mm_cmpgt_ps(dPhi, _mm_set1_ps(kPi));
+    __m128 wrapped = _mm_sub_ps(_mm_set1_ps(kTwoPi), dPhi);
+    return _mm_or_ps(_mm_and_ps(wrap, wrapped), _mm_andnot_ps(wrap, dPhi));
+  }
+
+  inline __m128 vecDeltaR(__m128 eta1, __m128 eta2, __m128 phi1, __m128 phi2) {
+    __m128 dEta = _mm_sub_ps(eta1, eta2);
+    __m128 dPhi = vecDeltaPhi(phi1, phi2);
+    return _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dEta, dEta), _mm_mul_ps(dPhi, dPhi)));
+  }
+
+  inline void vecDeltaPhiStore(float* out, float phiRef, const float* phi) {
+    _mm_storeu_ps(out, vecDeltaPhi(_mm_loadu_ps(phi), _mm_set1_ps(phiRef)));
+  }
+
+  inline void vecDeltaRStore(float* out, float etaRef, float phiRef, const float* eta, const float* phi) {
+    _mm_storeu_ps(out, vecDeltaR(_mm_loadu_ps(eta), _mm_set1_ps(etaRef),
+          _mm_loadu_ps(phi), _mm_set1_ps(phiRef)));
+  }
+#endif
+
+} // namespace
+
+
+void DeltaPhiOneToManyScalar(float phiRef, const float* phi, float* dPhi, unsigned int n){
+  for (unsigned int i = 0; i < n; i++) dPhi[i] = scalarDeltaPhi(phi[i], phiRef);
+}
+
+void DeltaROneToManyScalar(float etaRef, float phiRef, const float* eta, const float* phi, float* dR, unsigned int n){
+  for (unsigned int i = 0; i < n; i++) {
+    float dEta = eta[i] - etaRef;
+    float dPhi = scalarDeltaPhi(phi[i], phiRef);
+    dR[i] = std::sqrt(dEta*dEta + dPhi*dPhi);
+  }
+}
+
+void DeltaRPairwiseScalar(const float* eta1, const float* phi1, unsigned int n1,
+    const float* eta2, const float* phi2, unsigned int n2, float* dR){
+  for (unsigned int i = 0; i < n1; i++)
+    DeltaROneToManyScalar(eta1[i], phi1[i], eta2, phi2, dR + i*n2, n2);
+}
+
+
+void DeltaPhiOneToMany(float phiRef, const float* phi, float* dPhi, unsigned int n){
+  unsigned int i = 0;
+#if defined(__AVX__) || defined(__SSE2__)
+  for (; i + kWidth <= n; i += kWidth) vecDeltaPhiStore(dPhi + i, phiRef, phi + i);
+#endif
+  // remainder
+  DeltaPhiOneToManyScalar(phiRef, phi + i, dPhi + i, n - i);
+}
+
+void DeltaROneToMany(float etaRef, float phiRef, const float* eta, const float* phi, float* dR, unsigned int n){
+  unsigned int i = 0;
+#if defined(__AVX__) || defined(__SSE2__)
+  for (; i + kWidth <= n; i += kWidth) vecDeltaRStore(dR + i, etaRef, phiRef, eta + i, phi + i);
+#endif
+  // remainder
+  DeltaROneToManyScalar(etaRef, phiRef, eta + i, phi + i, dR + i, n - i);
+}
+
+void DeltaRPairwise(const float* eta1, const float* phi1, unsigned int n1,
+    const float* eta2, const float* phi2, unsigned int n2, float* dR){
+  for (unsigned int i = 0; i < n1; i++)
+    DeltaROneToMany(eta1[i], phi1[i], eta2, phi2, dR + i*n2, n2);
+}
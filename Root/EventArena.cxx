@@ -0,0 +1,69 @@
+#include <ZinvAnalysis/EventArena.h>
+
+#include "AthContainers/AuxTypeRegistry.h"
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(EventArena)
+
+EventArena::EventArena(){
+  m_numAllocations = 0;
+  m_totalAllocations = 0;
+  m_maxAllocations = 0;
+  m_numReuses = 0;
+  m_numEvents = 0;
+}
+
+EventArena::~EventArena(){
+  Destroy(m_eventCopies);
+  Destroy(m_slots);
+}
+
+EventArena::Entry* EventArena::Find(unsigned int slot){
+  if (slot >= m_slots.size()) {
+    Entry empty;
+    empty.object = 0;
+    empty.aux = 0;
+    empty.clear = 0;
+    empty.destroy = 0;
+    m_slots.resize(slot + 1, empty);
+  }
+  return &m_slots[slot];
+}
+
+void EventArena::Destroy(std::vector<Entry> &entries){
+  for (unsigned int i = 0; i < entries.size(); i++) {
+    if (entries[i].destroy) entries[i].destroy(entries[i].object, entries[i].aux);
+  }
+  entries.clear();
+}
+
+void EventArena::RestoreFromInput(xAOD::ShallowAuxContainer* aux, const SG::AuxVectorData& input){
+  const SG::IConstAuxStore* inputStore = input.getConstStore();
+  if (!inputStore) return;
+  const size_t size = inputStore->size();
+  const SG::auxid_set_t &inputIDs = inputStore->getAuxIDs();
+  // the copy's own variables: corrections and decorations of the previous pass
+  const SG::auxid_set_t ownIDs = aux->getWritableAuxIDs();
+  SG::AuxTypeRegistry &registry = SG::AuxTypeRegistry::instance();
+  for (SG::auxid_set_t::const_iterator id = ownIDs.begin(); id != ownIDs.end(); ++id) {
+    if (inputIDs.find(*id) == inputIDs.end()) continue;
+    const void* src = inputStore->getData(*id);
+    void* dst = aux->getData(*id, size, size);
+    if (!src || !dst) continue;
+    for (size_t i = 0; i < size; i++) registry.copy(*id, dst, i, src, i);
+  }
+}
+
+void EventArena::Reset(){
+  // views first: they may point into the shallow copies
+  for (unsigned int i = 0; i < m_slots.size(); i++) {
+    if (m_slots[i].clear) m_slots[i].clear(m_slots[i].object);
+  }
+  Destroy(m_eventCopies);
+  m_copySlots.clear();
+
+  if (m_numAllocations > m_maxAllocations) m_maxAllocations = m_numAllocations;
+  m_totalAllocations += m_numAllocations;
+  m_numAllocations = 0;
+  m_numEvents++;
+}
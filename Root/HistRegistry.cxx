@@ -0,0 +1,193 @@
+#include <ZinvAnalysis/HistRegistry.h>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(HistRegistry)
+
+namespace {
+
+  const char* channelTag[kNumHistChannels] = {
+    "", "h_znunu_", "h_zmumu_", "h_wmunu_", "h_zee_", "h_wenu_"
+  };
+
+  const char* channelLabel[kNumHistChannels] = {
+    "", "Znunu", "Zmumu", "Wmunu", "Zee", "Wenu"
+  };
+
+  const char* regionTag[kNumHistRegions] = {
+    "", "monojet_", "vbf_", "sm1_", "truth_monojet_", "truth_vbf_", "", ""
+  };
+
+  const char* variableName[] = {
+    "avg_interaction",
+    "MET_mono",
+    "MET_search",
+    "Mjj_search",
+    "DeltaPhiAll",
+    "met",
+    "mjj",
+    "dPhijj",
+    "njet",
+    "jet_pt",
+    "jet_phi",
+    "jet_eta",
+    "jet_rap",
+    "dPhimetjet",
+    "dPhiMinmetjet",
+    "jet1_pt",
+    "jet2_pt",
+    "jet3_pt",
+    "jet1_phi",
+    "jet2_phi",
+    "jet3_phi",
+    "jet1_eta",
+    "jet2_eta",
+    "jet3_eta",
+    "jet1_rap",
+    "jet2_rap",
+    "jet3_rap",
+    "dRjj",
+    "dPhimetj1",
+    "dPhimetj2",
+    "dPhimetj3",
+    "met_emulmet",
+    "met_emulmet_1bJet",
+    "mjj_1bJet",
+    "dPhijj_1bJet",
+    "met_emulmet_2bJet",
+    "mjj_2bJet",
+    "dPhijj_2bJet",
+    "lepton1_pt",
+    "lepton2_pt",
+    "lepton1_phi",
+    "lepton2_phi",
+    "lepton1_eta",
+    "lepton2_eta",
+    "mll",
+    "eff_study_met_emulmet",
+    "eff_study_met_emulmet_pass_HLT_xe70",
+    "eff_study_met_emulmet_pass_HLT_xe70_tclcw",
+    "eff_study_mjj_allmet",
+    "eff_study_dPhijj_allmet",
+    "eff_study_mjj_allmet_pass_HLT_xe70",
+    "eff_study_dPhijj_allmet_pass_HLT_xe70",
+    "eff_study_mjj_allmet_pass_HLT_xe70_tclcw",
+    "eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw",
+    "eff_study_mjj_met130",
+    "eff_study_dPhijj_met130",
+    "eff_study_mjj_met130_pass_HLT_xe70",
+    "eff_study_dPhijj_met130_pass_HLT_xe70",
+    "eff_study_mjj_met130_pass_HLT_xe70_tclcw",
+    "eff_study_dPhijj_met130_pass_HLT_xe70_tclcw",
+    "eff_study_mjj_met150",
+    "eff_study_dPhijj_met150",
+    "eff_study_mjj_met150_pass_HLT_xe70",
+    "eff_study_dPhijj_met150_pass_HLT_xe70",
+    "eff_study_mjj_met150_pass_HLT_xe70_tclcw",
+    "eff_study_dPhijj_met150_pass_HLT_xe70_tclcw",
+    "eff_study_mjj_met200",
+    "eff_study_dPhijj_met200",
+    "eff_study_mjj_met200_pass_HLT_xe70",
+    "eff_study_dPhijj_met200_pass_HLT_xe70",
+    "eff_study_mjj_met200_pass_HLT_xe70_tclcw",
+    "eff_study_dPhijj_met200_pass_HLT_xe70_tclcw",
+    "multijet_study_mll_all_lep",
+    "multijet_study_met_emulmet_all_lep",
+    "multijet_study_mll_os_lep",
+    "multijet_study_met_emulmet_os_lep",
+    "multijet_study_mll_ss_lep",
+    "multijet_study_met_emulmet_ss_lep",
+    "multijet_study_mjj_all_lep",
+    "multijet_study_dPhijj_all_lep",
+    "multijet_study_mjj_os_lep",
+    "multijet_study_dPhijj_os_lep",
+    "multijet_study_mjj_ss_lep",
+    "multijet_study_dPhijj_ss_lep",
+    "qcd_method2_nominal_cut_met150_200_mll",
+    "qcd_method2_nominal_cut_met200_300_mll",
+    "qcd_method2_nominal_cut_met300_500_mll",
+    "qcd_method2_nominal_cut_met500_inf_mll",
+    "qcd_method2_met150_200_count_mll",
+    "qcd_method2_met200_300_count_mll",
+    "qcd_method2_met300_500_count_mll",
+    "qcd_method2_met500_inf_count_mll",
+    "qcd_method2_case1_cut_met150_200_mll",
+    "qcd_method2_case1_cut_met200_300_mll",
+    "qcd_method2_case1_cut_met300_500_mll",
+    "qcd_method2_case1_cut_met500_inf_mll",
+    "qcd_method2_case2_cut_met150_200_mll",
+    "qcd_method2_case2_cut_met200_300_mll",
+    "qcd_method2_case2_cut_met300_500_mll",
+    "qcd_method2_case2_cut_met500_inf_mll",
+    "qcd_method2_case3_cut_met150_200_mll",
+    "qcd_method2_case3_cut_met200_300_mll",
+    "qcd_method2_case3_cut_met300_500_mll",
+    "qcd_method2_case3_cut_met500_inf_mll",
+    "qcd_method2_nominal_cut_met",
+    "NTauBefore",
+    "NEleBefore",
+    "NMuBefore",
+    "NMuZBefore",
+    "NJetBefore",
+    "NTauAfter",
+    "NEleAfter",
+    "NMuAfter",
+    "NMuZAfter",
+    "NJetAfter",
+    "met_cst",
+    "met_emulmet_cst",
+  };
+
+  static_assert(sizeof(variableName)/sizeof(variableName[0]) == kNumHistVariables,
+      "HistVariable enum and name table are out of sync");
+
+}
+
+HistRegistry::HistRegistry(){
+  m_slot.assign(kNumHistChannels*kNumHistRegions*kNumHistVariables, -1);
+  m_nSlots = 0;
+  m_nSys = 0;
+  m_numFills = 0;
+  m_fillWeightSys = false;
+}
+
+HistRegistry::~HistRegistry(){
+  /// histograms are owned by the EventLoop worker output
+}
+
+std::string HistRegistry::Name(int channel, int region, int variable, const std::string& sysName){
+  std::string name;
+  if (region == kRegRatio)
+    name = std::string(channelLabel[channel]) + "_";
+  else if (region == kRegEmily)
+    name = std::string("Emily_") + channelLabel[channel] + "_";
+  else
+    name = std::string(channelTag[channel]) + regionTag[region];
+  return name + variableName[variable] + sysName;
+}
+
+int HistRegistry::AddSystematic(const std::string& sysName){
+  std::map<std::string, int>::const_iterator it = m_sysIndex.find(sysName);
+  if (it != m_sysIndex.end()) return it->second;
+  m_sysIndex[sysName] = m_nSys;
+  return m_nSys++;
+}
+
+void HistRegistry::Register(int channel, int region, int variable, int sys, TH1* hist){
+  int &slot = m_slot[(channel*kNumHistRegions + region)*kNumHistVariables + variable];
+  if (slot < 0) slot = m_nSlots++;
+  Booking booking = {slot, sys, hist};
+  m_bookings.push_back(booking);
+}
+
+void HistRegistry::SetWeightSystematics(const std::vector<int>& sys){
+  m_weightSys = sys;
+  for (int i = 0; i < kNumHistWeights; i++)
+    m_weightVar[i].assign(sys.size(), 1.);
+}
+
+void HistRegistry::Freeze(){
+  m_hists.assign(m_nSlots*m_nSys, 0);
+  for (const auto &booking : m_bookings)
+    m_hists[booking.slot*m_nSys + booking.sys] = booking.hist;
+  m_bookings.clear();
+}
@@ -0,0 +1,85 @@
+#include <ZinvAnalysis/IsoTrackGrid.h>
+
+#include <TMath.h>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(IsoTrackGrid)
+
+IsoTrackGrid::IsoTrackGrid(float coneSize, float etaMax){
+  m_coneSize = coneSize;
+  m_etaMax = etaMax;
+  // cells at least as wide as the cone in both directions
+  m_nEta = int(2. * etaMax / coneSize);
+  if (m_nEta < 1) m_nEta = 1;
+  m_etaWidth = 2. * etaMax / m_nEta;
+  m_nPhi = int(TMath::TwoPi() / coneSize);
+  if (m_nPhi < 1) m_nPhi = 1;
+  m_phiWidth = TMath::TwoPi() / m_nPhi;
+  m_cellStart.assign(m_nEta * m_nPhi + 1, 0);
+}
+
+IsoTrackGrid::~IsoTrackGrid(){
+
+}
+
+void IsoTrackGrid::Clear(){
+  m_pt.clear();
+  m_eta.clear();
+  m_phi.clear();
+  m_cellTracks.clear();
+  m_trackCell.clear();
+  m_cellStart.assign(m_nEta * m_nPhi + 1, 0);
+}
+
+unsigned int IsoTrackGrid::Add(float pt, float eta, float phi){
+  m_pt.push_back(pt);
+  m_eta.push_back(eta);
+  m_phi.push_back(phi);
+  return m_pt.size() - 1;
+}
+
+int IsoTrackGrid::PhiBin(float phi) const {
+  int bin = int((phi + TMath::Pi()) / m_phiWidth);
+  return ((bin % m_nPhi) + m_nPhi) % m_nPhi;
+}
+
+void IsoTrackGrid::Build(){
+  const unsigned int nCells = m_nEta * m_nPhi;
+  m_cellStart.assign(nCells + 1, 0);
+  m_trackCell.resize(m_pt.size());
+
+  // counting sort of the tracks by cell
+  for (unsigned int i = 0; i < m_pt.size(); i++) {
+    m_trackCell[i] = EtaBin(m_eta[i]) * m_nPhi + PhiBin(m_phi[i]);
+    m_cellStart[m_trackCell[i] + 1]++;
+  }
+  for (unsigned int c = 0; c < nCells; c++) m_cellStart[c + 1] += m_cellStart[c];
+
+  m_cellTracks.resize(m_pt.size());
+  std::vector<unsigned int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+  for (unsigned int i = 0; i < m_pt.size(); i++) m_cellTracks[fill[m_trackCell[i]]++] = i;
+}
+
+int IsoTrackGrid::NumNeighbours(float eta, float phi, float ptMin, int skip) const {
+  const float cone2 = m_coneSize * m_coneSize;
+  const int etaBin = EtaBin(eta);
+  const int phiBin = PhiBin(phi);
+  const int nPhiCells = m_nPhi < 3 ? m_nPhi : 3;
+
+  int nCloseby = 0;
+  for (int ie = etaBin - 1; ie <= etaBin + 1; ie++) {
+    if (ie < 0 || ie >= m_nEta) continue;
+    for (int ip = 0; ip < nPhiCells; ip++) {
+      const int cell = ie * m_nPhi + ((phiBin + ip - 1 + m_nPhi) % m_nPhi);
+      for (unsigned int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; k++) {
+        const unsigned int i = m_cellTracks[k];
+        if (int(i) == skip || m_pt[i] < ptMin) continue;
+        const float dEta = m_eta[i] - eta;
+        float dPhi = fabs(m_phi[i] - phi);
+        if (dPhi > TMath::Pi()) dPhi = TMath::TwoPi() - dPhi;
+        if (dEta * dEta + dPhi * dPhi < cone2) nCloseby++;
+      }
+    }
+  }
+  return nCloseby;
+}
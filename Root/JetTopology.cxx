@@ -0,0 +1,93 @@
+#include <ZinvAnalysis/JetTopology.h>
+#include <ZinvAnalysis/DeltaKernels.h>
+
+#include <TMath.h>
+#include <algorithm>
+#include <cmath>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(JetTopology)
+
+namespace {
+
+  // same as ZinvxAODAnalysis::deltaPhi
+  inline float scalarDeltaPhi(float phi1, float phi2) {
+    float dPhi = std::fabs(phi1 - phi2);
+    if(dPhi > TMath::Pi()) dPhi = TMath::TwoPi() - dPhi;
+    return dPhi;
+  }
+
+}
+
+JetTopology::JetTopology(){
+  SetCuts(25000., 4.4, 30000., 30000., 4.4, 0.4);
+}
+
+JetTopology::~JetTopology(){
+
+}
+
+void JetTopology::SetCuts(float cjvPtCut, float cjvRapCut, float sm1VetoPtCut,
+    float dPhiJetPtCut, float dPhiJetRapCut, float dPhiCut){
+  m_cjvPtCut = cjvPtCut;
+  m_cjvRapCut = cjvRapCut;
+  m_sm1VetoPtCut = sm1VetoPtCut;
+  m_dPhiJetPtCut = dPhiJetPtCut;
+  m_dPhiJetRapCut = dPhiJetRapCut;
+  m_dPhiCut = dPhiCut;
+}
+
+void JetTopology::Compute(const ParticleStore& jets, const float* metPhi, unsigned int activeMask,
+    JetTopologyResult& result) const {
+  const unsigned int nJets = jets.Size();
+  const unsigned int nLead = nJets < kNumDPhiJets ? nJets : kNumDPhiJets;
+
+  result.nJets = nJets;
+  result.mjj = 0.;
+  result.dPhijj = 0.;
+  result.dRjj = 0.;
+  result.ht = 0.;
+  result.centralJet = false;
+  result.subleadingJet = false;
+
+  // dPhi(jet_i,MET) of the leading jets
+  for (unsigned int h = 0; h < kNumMetHypotheses; h++) {
+    for (unsigned int i = 0; i < kNumDPhiJets; i++) result.dPhiJetMet[h][i] = 0.;
+    result.dPhiMinJetMet[h] = 10.;
+    result.passDPhiJetMet[h] = true;
+    if (activeMask & (1 << h)) DeltaPhiOneToMany(metPhi[h], jets.PhiArray(), result.dPhiJetMet[h], nLead);
+  }
+
+  // dijet
+  float rapLow = 0., rapHigh = 0.;
+  if (nJets > 1) {
+    result.mjj = jets.Mass(0, 1);
+    result.dPhijj = scalarDeltaPhi(jets.Phi(0), jets.Phi(1));
+    float dEta = jets.Eta(0) - jets.Eta(1);
+    result.dRjj = TMath::Sqrt(dEta*dEta + result.dPhijj*result.dPhijj);
+    rapLow = std::min(jets.Rapidity(0), jets.Rapidity(1));
+    rapHigh = std::max(jets.Rapidity(0), jets.Rapidity(1));
+  }
+
+  // single pass over the jets
+  for (unsigned int i = 0; i < nJets; i++) {
+    const float pt = jets.Pt(i);
+    const float rapidity = jets.Rapidity(i);
+    result.ht += pt;
+
+    if (i < nLead) {
+      const bool cutJet = pt > m_dPhiJetPtCut && std::fabs(rapidity) < m_dPhiJetRapCut;
+      for (unsigned int h = 0; h < kNumMetHypotheses; h++) {
+        if (!(activeMask & (1 << h))) continue;
+        const float dPhi = result.dPhiJetMet[h][i];
+        if (cutJet && dPhi < m_dPhiCut) result.passDPhiJetMet[h] = false;
+        result.dPhiMinJetMet[h] = std::min(result.dPhiMinJetMet[h], dPhi);
+      }
+    }
+
+    if (i > 0 && pt > m_sm1VetoPtCut) result.subleadingJet = true;
+
+    if (i > 1 && pt > m_cjvPtCut && std::fabs(rapidity) < m_cjvRapCut &&
+        rapidity > rapLow && rapidity < rapHigh) result.centralJet = true;
+  }
+}
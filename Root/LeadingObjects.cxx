@@ -0,0 +1,36 @@
+#include <ZinvAnalysis/LeadingObjects.h>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(LeadingObjects)
+
+LeadingObjects::LeadingObjects(unsigned int numLeading){
+  m_numLeading = numLeading;
+}
+
+LeadingObjects::~LeadingObjects(){
+
+}
+
+void LeadingObjects::Clear(){
+  m_leading.clear();
+  m_leadingPt.clear();
+  m_others.clear();
+}
+
+void LeadingObjects::Add(xAOD::IParticle* particle){
+  const float pt = particle->pt();
+  unsigned int pos = m_leading.size();
+  while (pos > 0 && m_leadingPt[pos - 1] < pt) pos--;
+  if (pos >= m_numLeading) {
+    m_others.push_back(particle);
+    return;
+  }
+  // the last leading object moves to the others when the list is full
+  if (m_leading.size() == m_numLeading) {
+    m_others.push_back(m_leading.back());
+    m_leading.pop_back();
+    m_leadingPt.pop_back();
+  }
+  m_leading.insert(m_leading.begin() + pos, particle);
+  m_leadingPt.insert(m_leadingPt.begin() + pos, pt);
+}
@@ -12,4 +12,13 @@
 #ifdef __CINT__
 #pragma link C++ class ZinvxAODAnalysis+;
 #pragma link C++ class BitsetCutflow+;
+#pragma link C++ class HistRegistry+;
+#pragma link C++ class IsoTrackGrid+;
+#pragma link C++ class JetTopology+;
+#pragma link C++ class ParticleStore+;
+#pragma link C++ class DecisionCache+;
+#pragma link C++ class CutChain+;
+#pragma link C++ class EventArena+;
+#pragma link C++ class ObjectFlags+;
+#pragma link C++ class LeadingObjects+;
 #endif
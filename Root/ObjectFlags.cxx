@@ -0,0 +1,18 @@
+#include <ZinvAnalysis/ObjectFlags.h>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(ObjectFlags)
+
+ObjectFlags::ObjectFlags(){
+
+}
+
+ObjectFlags::~ObjectFlags(){
+
+}
+
+void ObjectFlags::Reset(unsigned int size){
+  const unsigned int nWords = (size + 63) / 64;
+  for (unsigned int f = 0; f < kNumObjectFlags; f++) m_bits[f].assign(nWords, 0ULL);
+  m_scaleFactor.assign(size, 1.);
+}
@@ -0,0 +1,47 @@
+#include <ZinvAnalysis/ParticleStore.h>
+#include <ZinvAnalysis/FourVector.h>
+
+/// this is needed to distribute the algorithm to the workers
+ClassImp(ParticleStore)
+
+ParticleStore::ParticleStore(){
+
+}
+
+ParticleStore::~ParticleStore(){
+
+}
+
+void ParticleStore::Clear(){
+  m_pt.clear();
+  m_eta.clear();
+  m_phi.clear();
+  m_m.clear();
+  m_rapidity.clear();
+  m_charge.clear();
+  m_index.clear();
+  m_flags.clear();
+}
+
+void ParticleStore::Add(float pt, float eta, float phi, float m, float rapidity,
+    float charge, unsigned int index, unsigned int flags){
+  m_pt.push_back(pt);
+  m_eta.push_back(eta);
+  m_phi.push_back(phi);
+  m_m.push_back(m);
+  m_rapidity.push_back(rapidity);
+  m_charge.push_back(charge);
+  m_index.push_back(index);
+  m_flags.push_back(flags);
+}
+
+unsigned int ParticleStore::CountFlag(unsigned int flag) const {
+  unsigned int n = 0;
+  for (unsigned int i = 0; i < m_flags.size(); i++) if (m_flags[i] & flag) n++;
+  return n;
+}
+
+float ParticleStore::Mass(unsigned int i, unsigned int j) const {
+  return (FourVector::PtEtaPhiM(m_pt[i], m_eta[i], m_phi[i], m_m[i]) +
+      FourVector::PtEtaPhiM(m_pt[j], m_eta[j], m_phi[j], m_m[j])).M();
+}
@@ -30,10 +30,6 @@
 static std::string jetType = "AntiKt4EMTopoJets";
 
 // Global accessors and decorators
-static SG::AuxElement::Decorator<char> dec_baseline("baseline");
-static SG::AuxElement::Decorator<char> dec_signal("signal");
-static SG::AuxElement::Decorator<char> dec_signal_forZ("signal_forZ");
-static SG::AuxElement::Decorator<char> dec_bad("bad");
 static SG::AuxElement::Accessor<float>  acc_jvt("Jvt");
 static SG::AuxElement::ConstAccessor<float> cacc_jvt("Jvt");
 // For ORTools
@@ -51,15 +47,212 @@ ort::objLinkAccessor_t objLinkAcc("overlapObject");
 //static const std::string outputLabel = outputPassValue? "passOR" : "overlaps";
 //static SG::AuxElement::Decorator<char> dec_overlap(outputLabel);
 
-// Scale Factor decorators
-static SG::AuxElement::Decorator<double> dec_scalefactor("scalefactor");
-
 struct DescendingPt:std::function<bool(const xAOD::IParticle*, const xAOD::IParticle*)> {
   bool operator()(const xAOD::IParticle* l, const xAOD::IParticle* r)  const {
     return l->pt() > r->pt();
   }
 };
 
+// MET magnitude and phi from its components
+static void setMET(double mpx, double mpy, float &met, float &met_phi) {
+  met = TMath::Sqrt(mpx * mpx + mpy * mpy);
+  met_phi = TMath::ATan2(mpy, mpx);
+}
+
+// Charge of the objects kept in a ParticleStore (0 for neutral objects)
+static float particleCharge(const xAOD::Muon* muon) { return muon->charge(); }
+static float particleCharge(const xAOD::Electron* electron) { return electron->charge(); }
+static float particleCharge(const xAOD::TauJet* tau) { return tau->charge(); }
+static float particleCharge(const xAOD::IParticle*) { return 0.; }
+
+// Copy the kinematics of a selected view container into its ParticleStore
+template <class T>
+static void fillParticleStore(const T& particles, ParticleStore& store) {
+  store.Clear();
+  for (const auto& particle : particles)
+    store.Add(particle->pt(), particle->eta(), particle->phi(), particle->m(), particle->rapidity(),
+        particleCharge(particle), particle->index());
+}
+
+// Cuts and stages of the object cut chains (declared in this order in initialize())
+enum MuonCut { kMuonCutPt, kMuonCutLoose, kMuonCutZ0, kMuonCutD0Sig, kMuonCutIso };
+enum MuonStage { kMuonStageBaseline, kMuonStageForZ, kMuonStageSignal };
+enum ElectronCut { kElecCutEta, kElecCutPt, kElecCutOQ, kElecCutD0Sig, kElecCutZ0, kElecCutLH, kElecCutIso };
+enum ElectronStage { kElecStageBaseline, kElecStageID, kElecStageSignal };
+enum PhotonCut { kPhotCutEta, kPhotCutPt, kPhotCutOQ, kPhotCutTight, kPhotCutIso };
+enum PhotonStage { kPhotStageBaseline, kPhotStageSignal };
+enum TauCut { kTauCutSelection };
+enum TauStage { kTauStageSignal };
+
+// Containers of execute() owned by the event arena
+enum ArenaSlot {
+  kArenaGoodJet, kArenaGoodMuon, kArenaGoodMuonForZ, kArenaBaselineMuon, kArenaGoodElectron,
+  kArenaBaselineElectron, kArenaGoodTau, kArenaGoodPhoton, kArenaMET,
+  kArenaTruthNeutrino, kArenaTruthMuon, kArenaTruthElectron, kArenaTruthTau, kArenaTruthJet,
+  kArenaMetElectrons, kArenaMetTaus, kArenaMetMuons, kArenaInvisibleMuonsForZ
+};
+// Shallow copies of the arena: the nominal one, and one shared by the varied passes
+enum ArenaCopy {
+  kCopyNominalMuons, kCopyNominalElectrons, kCopyNominalPhotons, kCopyNominalTaus, kCopyNominalJets,
+  kCopyVariedMuons, kCopyVariedElectrons, kCopyVariedPhotons, kCopyVariedTaus, kCopyVariedJets,
+  kNumArenaCopies
+};
+// Collections ordered in pt while they are filled
+enum LeadingCollection {
+  kLeadGoodJet, kLeadGoodMuon, kLeadGoodMuonForZ, kLeadBaselineMuon, kLeadGoodElectron, kLeadBaselineElectron,
+  kNumLeadingCollections
+};
+// Steps of the event cutflow, registered in this order in initialize()
+enum CutflowStep {
+  kCutGRL,
+  kCutLArTileCore,
+  kCutPrimaryVertex,
+  kCutJetCleaning,
+  kCutZnunuMETTrigger,
+  kCutZnunuMETCut,
+  kCutZnunuElectronVeto,
+  kCutZnunuMuonVeto,
+  kCutZnunuTauVeto,
+  kCutZnunuAtLeastOneJets,
+  kCutZnunuMonojetMonoJet,
+  kCutZnunuMonojetDPhiJetMETCut,
+  kCutZnunuVBFDiJet,
+  kCutZnunuVBFMjjCut,
+  kCutZnunuVBFCJVCut,
+  kCutZnunuVBFDPhiJetMETCut,
+  kCutZmumuMETTrigger,
+  kCutZmumuMETCut,
+  kCutZmumuElectronVeto,
+  kCutZmumuAtLeastTwoMuons,
+  kCutZmumuTauVeto,
+  kCutZmumuMllCut,
+  kCutZmumuAtLeastOneJets,
+  kCutZmumuMonojetMonoJet,
+  kCutZmumuMonojetDPhiJetMETCut,
+  kCutZmumuVBFDiJet,
+  kCutZmumuVBFMjjCut,
+  kCutZmumuVBFCJVCut,
+  kCutZmumuVBFDPhiJetMETCut,
+  kCutZeeElectronTrigger,
+  kCutZeeMETCut,
+  kCutZeeAtLeastTwoElectron,
+  kCutZeeMuonVeto,
+  kCutZeeTauVeto,
+  kCutZeeMllCut,
+  kCutZeeAtLeastOneJets,
+  kCutZeeMonojetMonoJet,
+  kCutZeeMonojetDPhiJetMETCut,
+  kCutZeeVBFDiJet,
+  kCutZeeVBFMjjCut,
+  kCutZeeVBFCJVCut,
+  kCutZeeVBFDPhiJetMETCut,
+  kCutEmilyZmumuSkimCuts,
+  kCutEmilyZmumuAtLeastTwoMuon,
+  kCutEmilyZmumuOppositeSignCharge,
+  kCutEmilyZmumuDimuonPTCut,
+  kCutEmilyZmumuMETTrigger,
+  kCutEmilyZmumuZmassWindow,
+  kCutEmilyZmumuMETCut,
+  kCutEmilyZmumuExactTwoMuon,
+  kCutEmilyZmumuElectronVeto,
+  kCutEmilyZmumuTauVeto,
+  kCutEmilyZmumuMonojetCut,
+  kCutEmilyZmumuVBFCut,
+  kCutEmilyZeeSkimCuts,
+  kCutEmilyZeeAtLeastTwoElectron,
+  kCutEmilyZeeOppositeSignCharge,
+  kCutEmilyZeeDielectronPTCut,
+  kCutEmilyZeeElectronTrigger,
+  kCutEmilyZeeZmassWindow,
+  kCutEmilyZeeMETCut,
+  kCutEmilyZeeMuonVeto,
+  kCutEmilyZeeExactTwoElectrons,
+  kCutEmilyZeeTauVeto,
+  kCutEmilyZeeMonojetCut,
+  kCutEmilyZeeVBFCut,
+  kNumCutflowSteps
+};
+static const char* cutflowStepName[] = {
+  "GRL",
+  "LAr_Tile_Core",
+  "Primary vertex",
+  "Jet Cleaning",
+  "[Znunu]MET Trigger",
+  "[Znunu]MET cut",
+  "[Znunu]Electron Veto",
+  "[Znunu]Muon Veto",
+  "[Znunu]Tau Veto",
+  "[Znunu]At least One Jets",
+  "[Znunu, monojet]MonoJet",
+  "[Znunu, monojet]dPhi(jet_i,MET) cut",
+  "[Znunu, VBF]DiJet",
+  "[Znunu, VBF]mjj cut",
+  "[Znunu, VBF]CJV cut",
+  "[Znunu, VBF]dPhi(jet_i,MET) cut",
+  "[Zmumu]MET Trigger",
+  "[Zmumu]MET cut",
+  "[Zmumu]Electron Veto",
+  "[Zmumu]At least Two Muons",
+  "[Zmumu]Tau Veto",
+  "[Zmumu]mll cut",
+  "[Zmumu]At least One Jets",
+  "[Zmumu, monojet]MonoJet",
+  "[Zmumu, monojet]dPhi(jet_i,MET) cut",
+  "[Zmumu, VBF]DiJet",
+  "[Zmumu, VBF]mjj cut",
+  "[Zmumu, VBF]CJV cut",
+  "[Zmumu, VBF]dPhi(jet_i,MET) cut",
+  "[Zee]Electron Trigger",
+  "[Zee]MET cut",
+  "[Zee]At least Two Electron",
+  "[Zee]Muon Veto",
+  "[Zee]Tau Veto",
+  "[Zee]mll cut",
+  "[Zee]At least One Jets",
+  "[Zee, monojet]MonoJet",
+  "[Zee, monojet]dPhi(jet_i,MET) cut",
+  "[Zee, VBF]DiJet",
+  "[Zee, VBF]mjj cut",
+  "[Zee, VBF]CJV cut",
+  "[Zee, VBF]dPhi(jet_i,MET) cut",
+  "[Emily, Zmumu]Skim cuts",
+  "[Emily, Zmumu]At least Two Muon",
+  "[Emily, Zmumu]Opposite sign charge",
+  "[Emily, Zmumu]Dimuon pT cut",
+  "[Emily, Zmumu]MET Trigger",
+  "[Emily, Zmumu]Zmass window",
+  "[Emily, Zmumu]MET cut",
+  "[Emily, Zmumu]Exact two muon",
+  "[Emily, Zmumu]Electron veto",
+  "[Emily, Zmumu]Tau veto",
+  "[Emily, Zmumu]Monojet cut",
+  "[Emily, Zmumu]VBF cut",
+  "[Emily, Zee]Skim cuts",
+  "[Emily, Zee]At least Two Electron",
+  "[Emily, Zee]Opposite sign charge",
+  "[Emily, Zee]Dielectron pT cut",
+  "[Emily, Zee]Electron Trigger",
+  "[Emily, Zee]Zmass window",
+  "[Emily, Zee]MET cut",
+  "[Emily, Zee]Muon veto",
+  "[Emily, Zee]Exact two electrons",
+  "[Emily, Zee]Tau veto",
+  "[Emily, Zee]Monojet cut",
+  "[Emily, Zee]VBF cut",
+};
+static_assert(sizeof(cutflowStepName)/sizeof(cutflowStepName[0]) == kNumCutflowSteps,
+    "cutflowStepName out of sync with CutflowStep");
+
+// Decision of a selection tool, taken from the per-event cache while it is valid
+template <class Tool, class T>
+static bool cachedAccept(DecisionCache* cache, unsigned int decision, Tool* tool, const T& object, float key) {
+  int cached = cache->Get(decision, object.index(), key);
+  if (cached >= 0) return cached;
+  bool accept = tool->accept(object);
+  cache->Set(decision, object.index(), key, accept);
+  return accept;
+}
+
 
 // Helper macro for checking xAOD::TReturnCode return values
 #define EL_RETURN_CHECK( CONTEXT, EXP )                     \
@@ -86,6 +279,9 @@ ZinvxAODAnalysis :: ZinvxAODAnalysis ()
   // called on both the submission and the worker node.  Most of your
   // initialization code will go into histInitialize() and
   // initialize().
+
+  sysSliceIndex = 0;
+  sysSliceCount = 1;
 }
 
 
@@ -230,12 +426,15 @@ EL::StatusCode ZinvxAODAnalysis :: fileExecute ()
     //Info("execute()", " Event # = %llu, sumOfweights = %f, mcEventWeight = %f", eventInfo->eventNumber(), sumOfWeights, eventInfo->mcEventWeight());
     //Info("execute()", " Event # = %llu, nEventsProcessed = %d, sumOfweights = %f, sumOfWeightsSquared = %f", eventInfo->eventNumber(), nEventsProcessed, sumOfWeights, sumOfWeightsSquared);
 
-    h_sumOfWeights -> Fill(1, sumOfWeightsDxAOD);
-    h_sumOfWeights -> Fill(2, sumOfWeightsSquaredDxAOD);
-    h_sumOfWeights -> Fill(3, nEventsDxAOD);
-    h_sumOfWeights -> Fill(4, sumOfWeights);
-    h_sumOfWeights -> Fill(5, sumOfWeightsSquared);
-    h_sumOfWeights -> Fill(6, nEventsProcessed);
+    // bookkeeping is filled by the nominal slice only, so that merged slices count each file once
+    if (sysSliceIndex == 0) {
+      h_sumOfWeights -> Fill(1, sumOfWeightsDxAOD);
+      h_sumOfWeights -> Fill(2, sumOfWeightsSquaredDxAOD);
+      h_sumOfWeights -> Fill(3, nEventsDxAOD);
+      h_sumOfWeights -> Fill(4, sumOfWeights);
+      h_sumOfWeights -> Fill(5, sumOfWeightsSquared);
+      h_sumOfWeights -> Fill(6, nEventsProcessed);
+    }
 
     //Info("execute()", " Event # = %llu, sumOfWeights/nEventsProcessed = %f", eventInfo->eventNumber(), sumOfWeights/double(nEventsProcessed));
   }
@@ -300,6 +499,17 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
   m_useBitsetCutflow = true;
   m_isEmilyCutflow = false;
 
+  // Systematics slice run by this job (see sysSliceIndex)
+  if (sysSliceCount < 1 || sysSliceIndex < 0 || sysSliceIndex >= sysSliceCount) {
+    Error("initialize()", "Invalid systematics slice %i of %i. Exiting.", sysSliceIndex, sysSliceCount);
+    return EL::StatusCode::FAILURE;
+  }
+  // the cutflow is a nominal-only output
+  if (sysSliceIndex != 0) {
+    m_useArrayCutflow = false;
+    m_useBitsetCutflow = false;
+  }
+
   // Event Channel
   m_isZnunu = true;
   m_isZmumu = true;
@@ -309,6 +519,19 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
 
   // Enable Systematics
   m_doSys = true;
+  // Fill the weight-only systematics (scale factors, pileup) from the nominal selection pass
+  m_doWeightSysFastPath = true;
+  // Skip the systematic passes of events that cannot reach any region under any variation
+  // (keep it off until a m_validateSysEnvelope run reports no wrongly skipped pass)
+  m_doSysEnvelope = false;
+  // Run the skipped passes anyway and report the events where the envelope was wrong
+  m_validateSysEnvelope = false;
+  // Rebuild the emulated MET hypotheses derived from the real MET terms and compare them
+  m_validateEmulatedMET = false;
+  // Isolated track veto on top of the Znunu tau veto
+  m_doIsoTrackVeto = true;
+  // Reorder the object selection cuts by measured cost and rejection
+  m_doAdaptiveCutOrder = true;
 
   // Cut values
   m_muonPtCut = 7000.; /// MeV
@@ -328,6 +551,9 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
   m_diJetRapCut = 4.4;
   m_CJVptCut = 25000.; ///MeV
   m_metCut = 200000.; ///MeV
+  m_envelopeJetShift = 0.25; /// maximum relative JES/JER shift
+  m_envelopeLeptonShift = 0.05; /// maximum relative lepton/photon/tau shift
+  m_envelopeJetMigrationPt = 60000.; ///MeV, softer jets can join or leave RefJet (pt and JVT cuts)
   m_mjjCut = 200000.; ///MeV
   m_LeadLepPtCut = 80000.; ///MeV
   m_SubLeadLepPtCut = 7000.; ///MeV
@@ -699,6 +925,9 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
   EL_RETURN_CHECK("initialize()",m_metMaker->setProperty("JetMinEFrac", 0.0));
   //m_metMaker->msg().setLevel( MSG::VERBOSE ); // or DEBUG or VERBOSE
   EL_RETURN_CHECK("initialize()",m_metMaker->initialize());
+  // Emulated MET validation counters
+  m_numEmulMETCompared = 0;
+  m_numEmulMETMismatches = 0;
 
   // Initialize the harmonization reccommendation tools
   const bool doTaus = true, doPhotons = false;
@@ -783,6 +1012,52 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
   const CP::SystematicRegistry& registry = CP::SystematicRegistry::getInstance();
   const CP::SystematicSet& recommendedSystematics = registry.recommendedSystematics(); // get list of recommended systematics
   m_sysList = CP::make_systematics_vector(recommendedSystematics); 
+
+  // Dependency map: collections and weights touched by each systematic, from
+  // the affecting systematics of the tools applied to them. execute() only
+  // rebuilds the affected stages and reuses the nominal results otherwise.
+  // The same table drives the tool switching in execute(): a tool is only
+  // reconfigured when the systematic affects it or when it has to go back
+  // to its nominal configuration.
+  m_systematicsTools = {
+    {m_jerSmearingTool, "JERSmearingTool", kSysJets},
+    {m_jetUncertaintiesTool, "JetUncertaintiesTool", kSysJets},
+    {m_muonEfficiencySFTool, "MuonEfficiencyScaleFactorsToolSF", kSysMuonWeight},
+    {m_muonIsolationSFTool, "MuonIsolationEfficiencyScaleFactorsToolSF", kSysMuonWeight},
+    {m_muonTTVAEfficiencySFTool, "MuonTTVAEfficiencyScaleFactorsToolSF", kSysMuonWeight},
+    {m_muonCalibrationAndSmearingTool, "MuonCalibrationAndSmearingTool", kSysMuons},
+    {m_elecEfficiencySFTool_reco, "electronEfficiencyCorrectionToolRecoSF", kSysElectronWeight},
+    {m_elecEfficiencySFTool_id_Loose, "electronEfficiencyCorrectionToolIdLooseSF", kSysElectronWeight},
+    {m_elecEfficiencySFTool_id_Tight, "electronEfficiencyCorrectionToolIdTightSF", kSysElectronWeight},
+    {m_elecEfficiencySFTool_iso_Loose, "electronEfficiencyCorrectionToolIsoSFlooseID", kSysElectronWeight},
+    {m_elecEfficiencySFTool_iso_Tight, "electronEfficiencyCorrectionToolIsoSFtightID", kSysElectronWeight},
+    {m_elecEfficiencySFTool_trigSF_Loose, "electronEfficiencyCorrectionToolTriggerSFloose", kSysElectronWeight},
+    {m_egammaCalibrationAndSmearingTool, "EgammaCalibrationAndSmearingTool", kSysElectrons | kSysPhotons},
+    {m_isoCorrTool, "IsolationCorrectionTool", kSysElectrons},
+    {m_tauEffTool, "TauEfficiencyCorrectionsTool", kSysTauWeight},
+    {m_tauSmearingTool, "TauSmearingTool", kSysTaus},
+    {m_metSystTool, "METSystematicsTool", kSysMETSoftTerm},
+    {m_prwTool, "PileupReweightingTool", kSysPileupWeight}
+  };
+  std::vector<CP::SystematicSet> toolAffecting;
+  for (const auto &tool : m_systematicsTools) toolAffecting.push_back(tool.tool->affectingSystematics());
+  std::vector<unsigned int> sysDependencies(m_sysList.size(), 0);
+  std::vector<unsigned int> sysTools(m_sysList.size(), 0);
+  for (unsigned int i = 0; i < m_sysList.size(); i++) {
+    for (const auto &sysVar : m_sysList[i]) {
+      for (unsigned int t = 0; t < m_systematicsTools.size(); t++) {
+        if (toolAffecting[t].find(sysVar) == toolAffecting[t].end()) continue;
+        sysDependencies[i] |= m_systematicsTools[t].dependencies;
+        sysTools[i] |= 1u << t;
+      }
+    }
+  }
+  // tools start in their nominal configuration
+  m_variedTools = 0;
+  m_numToolSwitches = 0;
+  m_numToolSwitchesAll = 0;
+  m_numEnvelopeSkipped = 0;
+  m_numEnvelopeFailures = 0;
 /*
   std::vector<std::string> variations = {"JET_GroupedNP_1", "JET_GroupedNP_2", "JET_GroupedNP_3", "JET_EtaIntercalibration_NonClosure"};
   for (auto &s : variations) {
@@ -794,8 +1069,16 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
 */
 
   // Initialize Cutflow
-  if (m_useBitsetCutflow)
+  if (m_useBitsetCutflow) {
     m_BitsetCutflow = new BitsetCutflow(wk());
+    // the handles of the steps are their CutflowStep values (fails on a repeated step name)
+    for (unsigned int i = 0; i < kNumCutflowSteps; i++) {
+      if (m_BitsetCutflow->RegisterStep(cutflowStepName[i]) != i) {
+        Error("initialize()", "Cutflow step %s is registered twice. Exiting.", cutflowStepName[i]);
+        return EL::StatusCode::FAILURE;
+      }
+    }
+  }
 
 
   // Initialize Cutflow count array
@@ -823,9 +1106,85 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
 
   TH1::SetDefaultSumw2(kTRUE);
 
-  for (const auto &sysList : m_sysList){
-    if ((!m_doSys || m_isData) && (sysList).name() != "") continue;
-    std::string sysName = (sysList).name();
+  // Histogram registry (integer handles used in execute())
+  m_histRegistry = new HistRegistry();
+
+  // Isolated track veto
+  m_isoTrackGrid = new IsoTrackGrid(0.4, 2.5);
+
+  // Containers of execute(), reused from event to event
+  m_eventArena = new EventArena();
+  // Selection flags of each shallow copy of the arena
+  m_copyFlags.resize(kNumArenaCopies);
+  m_muonFlags = 0;
+  m_elecFlags = 0;
+  m_photFlags = 0;
+  m_tauFlags = 0;
+  m_jetFlags = 0;
+  // Leading objects of the good collections: all jets are ordered, the two leading leptons
+  m_leadingObjects.resize(kNumLeadingCollections);
+  m_leadingObjects[kLeadGoodJet] = LeadingObjects(LeadingObjects::kAllObjects);
+
+  // Object decisions reused across the systematic passes of an event.
+  // Decisions reading the calibrated pt are only reused for an unchanged pt;
+  // the tau and b-tagging tools only cut on pt at their threshold (20 GeV in
+  // recommended_selection_mc15_VBF.conf, MinPt of m_BJetSelectTool)
+  m_decisionCache = new DecisionCache();
+  m_decisionCache->SetRule(kDecMuonLoose, kRuleSameKey);
+  m_decisionCache->SetRule(kDecElectronOQ, kRuleAlways);
+  m_decisionCache->SetRule(kDecElectronLH, kRuleSameKey);
+  m_decisionCache->SetRule(kDecTau, kRuleSameSide, 20000.);
+  m_decisionCache->SetRule(kDecJetCleanLoose, kRuleSameKey);
+  m_decisionCache->SetRule(kDecJetCleanTight, kRuleSameKey);
+  m_decisionCache->SetRule(kDecBTag, kRuleSameSide, 30000.);
+
+  // Object cut chains: the cuts of a stage are reordered by cost / rejection
+  // after the warm-up; stages are split where decorations or corrections are applied
+  m_muonCuts = new CutChain("Muon");
+  m_muonCuts->AddCut(kMuonStageBaseline, "pt");
+  m_muonCuts->AddCut(kMuonStageBaseline, "loose");
+  m_muonCuts->AddCut(kMuonStageBaseline, "z0sintheta");
+  m_muonCuts->AddCut(kMuonStageForZ, "d0sig");
+  m_muonCuts->AddCut(kMuonStageSignal, "isolation");
+  m_elecCuts = new CutChain("Electron");
+  m_elecCuts->AddCut(kElecStageBaseline, "eta");
+  m_elecCuts->AddCut(kElecStageBaseline, "pt");
+  m_elecCuts->AddCut(kElecStageBaseline, "OQ");
+  m_elecCuts->AddCut(kElecStageBaseline, "d0sig");
+  m_elecCuts->AddCut(kElecStageBaseline, "z0sintheta");
+  m_elecCuts->AddCut(kElecStageID, "LHLoose");
+  m_elecCuts->AddCut(kElecStageSignal, "isolation");
+  m_photCuts = new CutChain("Photon");
+  m_photCuts->AddCut(kPhotStageBaseline, "eta");
+  m_photCuts->AddCut(kPhotStageBaseline, "pt");
+  m_photCuts->AddCut(kPhotStageBaseline, "OQ");
+  m_photCuts->AddCut(kPhotStageSignal, "tightIsEM");
+  m_photCuts->AddCut(kPhotStageSignal, "isolation");
+  m_tauCuts = new CutChain("Tau");
+  m_tauCuts->AddCut(kTauStageSignal, "selection");
+  m_muonCuts->SetAdaptive(m_doAdaptiveCutOrder);
+  m_elecCuts->SetAdaptive(m_doAdaptiveCutOrder);
+  m_photCuts->SetAdaptive(m_doAdaptiveCutOrder);
+  m_tauCuts->SetAdaptive(m_doAdaptiveCutOrder);
+
+  // Jet topology (CJV, SM1 subleading jet veto, dPhi(jet_i,MET) cut)
+  m_jetTopology = new JetTopology();
+  m_jetTopology->SetCuts(m_CJVptCut, m_diJetRapCut, 30000., 30000., 4.4, 0.4);
+
+  m_histChannel = kChInclusive;
+  m_histSys = -1;
+
+  // Resolve once which systematics are active for the configured channels,
+  // data/MC mode and systematics slice; execute() only loops over these descriptors
+  std::vector<ActiveSystematic> activeSystematics;
+  m_selectionSystematics.clear();
+  m_weightSystematics.clear();
+  m_softTermSystematics.clear();
+  unsigned int nSliceableSys = 0;
+  std::vector<std::string> unappliedSystematics;
+  for (unsigned int i = 0; i < m_sysList.size(); i++) {
+    std::string sysName = m_sysList[i].name();
+    if ((!m_doSys || m_isData) && sysName != "") continue;
 
     if (m_doSys && (sysName.find("TAUS_")!=std::string::npos || sysName.find("PH_")!=std::string::npos )) continue;
     if (m_isZmumu && !m_isZee && !m_isZnunu && m_doSys && ((sysName.find("EL_")!=std::string::npos || sysName.find("EG_")!=std::string::npos))) continue;
@@ -838,80 +1197,120 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
     //if (m_isZee   && m_doSys && sysName != "" &&  sysName != "EL_EFF_ID_TotalCorrUncertainty__1down" && sysName != "EL_EFF_ID_TotalCorrUncertainty__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1down") continue
     //if (m_isZnunu && m_doSys && sysName != "" &&  sysName != "JET_EtaIntercalibration_Modelling__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1down") continue;
 
+    // Systematics of tools missing from m_systematicsTools (JvtEfficiency, muon
+    // trigger SF, ...) vary nothing this analysis applies. They are still booked
+    // and filled, with the nominal weight, as the full selection pass did.
+    if (sysName != "" && sysDependencies[i] == 0) unappliedSystematics.push_back(sysName);
+
+    ActiveSystematic activeSys;
+    activeSys.index = i;
+    activeSys.name = sysName;
+    activeSys.isNominal = (sysName == "");
+    activeSys.dependencies = sysDependencies[i];
+    activeSys.tools = sysTools[i];
+
+    // Weight-only systematics: same objects and MET as the nominal, only the
+    // event weight changes. They are filled from the nominal pass instead of
+    // running their own selection pass.
+    const bool weightOnly = m_doWeightSysFastPath && !m_isData && !activeSys.isNominal &&
+      !(activeSys.dependencies & (kSysObjects | kSysMETSoftTerm));
+
+    // The nominal and weight-only systematics belong to slice 0, the other
+    // selection passes are dealt round-robin over the slices
+    const int slice = (activeSys.isNominal || weightOnly) ? 0 : int(nSliceableSys++ % sysSliceCount);
+    if (slice != sysSliceIndex) continue;
+
+    activeSys.hist = m_histRegistry->AddSystematic(sysName);
+    activeSystematics.push_back(activeSys);
+    if (weightOnly) m_weightSystematics.push_back(activeSys);
+    else m_selectionSystematics.push_back(activeSys);
+    if (activeSys.dependencies & kSysMETSoftTerm) m_softTermSystematics.push_back(m_sysList[i]);
+  }
+  // The passes without a soft term variation use the nominal soft term
+  if (!m_softTermSystematics.empty()) m_softTermSystematics.push_back(CP::SystematicSet());
+  Info("initialize()", "Systematics slice %i of %i: %lu selection passes, %lu weight-only systematics",
+      sysSliceIndex, sysSliceCount, m_selectionSystematics.size(), m_weightSystematics.size());
+  for (const auto &sysName : unappliedSystematics)
+    Info("initialize()", "Systematic %s is not applied by any tool of the analysis, filled with the nominal weight", sysName.c_str());
 
+  for (const auto &activeSys : activeSystematics){
+    const std::string &sysName = activeSys.name;
 
     // Number of Interactions
     if (sysName == ""){
-      addHist(hMap1D, "avg_interaction"+sysName, 40, 0., 40.);
+      addHist(hMap1D, kChInclusive, kRegNone, kVar_avg_interaction, sysName, 40, 0., 40.);
     }
 
 
     if (m_isZnunu) {
-      h_channel = "h_znunu_";
+      m_histChannel = kChZnunu;
 
       // For Ratio plot
-      addHist(hMap1D, "Znunu_MET_mono"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, "Znunu_MET_search"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, "Znunu_Mjj_search"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, "Znunu_DeltaPhiAll"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, kChZnunu, kRegRatio, kVar_MET_mono, sysName, nbinMET, binsMET);
+      addHist(hMap1D, kChZnunu, kRegRatio, kVar_MET_search, sysName, nbinMET, binsMET);
+      addHist(hMap1D, kChZnunu, kRegRatio, kVar_Mjj_search, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, kChZnunu, kRegRatio, kVar_DeltaPhiAll, sysName, nbinDPhi, binsDPhi);
 
       // For publication
-      addHist(hMap1D, h_channel+"monojet_met"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_cst, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_cst, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj, sysName, nbinDPhi, binsDPhi);
 
       // Number of Interactions
-      addHist(hMap1D, h_channel+"monojet_avg_interaction"+sysName, 40, 0., 40.);
-      addHist(hMap1D, h_channel+"vbf_avg_interaction"+sysName, 40, 0., 40.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_avg_interaction, sysName, 40, 0., 40.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_avg_interaction, sysName, 40, 0., 40.);
 
       if (sysName == ""){
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
         // Jets
-        addHist(hMap1D, h_channel+"monojet_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"monojet_jet_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"monojet_jet_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_jet_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_jet_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_dPhimetjet"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"monojet_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_dPhimetjet, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         ////////////////////
         // VBF phasespace //
         ////////////////////
         // Jets
-        addHist(hMap1D, h_channel+"vbf_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"vbf_jet1_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet2_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet3_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet3_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet3_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet1_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet2_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet3_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_dRjj"+sysName, 25, 0., 5.);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj1"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj2"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj3"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dRjj, sysName, 25, 0., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj1, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj2, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj3, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         ////////////////////
         // SM1 phasespace //
         ////////////////////
         // For publication
-        addHist(hMap1D, h_channel+"sm1_met"+sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_met, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_met_cst, sysName, nbinMET, binsMET);
         // Jets
-        addHist(hMap1D, h_channel+"sm1_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"sm1_jet_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"sm1_jet_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_jet_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_jet_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_dPhimetjet"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"sm1_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_dPhimetjet, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
 
       }
 
@@ -920,138 +1319,141 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
 
 
     if (m_isZmumu) {
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
 
       // For Ratio plot
-      addHist(hMap1D, "Zmumu_MET_mono"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, "Zmumu_MET_search"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, "Zmumu_Mjj_search"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, "Zmumu_DeltaPhiAll"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, kChZmumu, kRegRatio, kVar_MET_mono, sysName, nbinMET, binsMET);
+      addHist(hMap1D, kChZmumu, kRegRatio, kVar_MET_search, sysName, nbinMET, binsMET);
+      addHist(hMap1D, kChZmumu, kRegRatio, kVar_Mjj_search, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, kChZmumu, kRegRatio, kVar_DeltaPhiAll, sysName, nbinDPhi, binsDPhi);
 
       // For publication
-      addHist(hMap1D, h_channel+"monojet_met_emulmet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met_emulmet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet_cst, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet_cst, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj, sysName, nbinDPhi, binsDPhi);
 
       // For Top enhanced control region
       // At least 1 bJet
-      addHist(hMap1D, h_channel+"monojet_met_emulmet_1bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met_emulmet_1bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj_1bJet"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj_1bJet"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet_1bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet_1bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj_1bJet, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj_1bJet, sysName, nbinDPhi, binsDPhi);
       // At least 2 bJet
-      addHist(hMap1D, h_channel+"monojet_met_emulmet_2bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met_emulmet_2bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj_2bJet"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj_2bJet"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet_2bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet_2bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj_2bJet, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj_2bJet, sysName, nbinDPhi, binsDPhi);
 
       // Number of Interactions
-      addHist(hMap1D, h_channel+"monojet_avg_interaction"+sysName, 40, 0., 40.);
-      addHist(hMap1D, h_channel+"vbf_avg_interaction"+sysName, 40, 0., 40.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_avg_interaction, sysName, 40, 0., 40.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_avg_interaction, sysName, 40, 0., 40.);
 
       if (sysName == ""){
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
         // Jets
-        addHist(hMap1D, h_channel+"monojet_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"monojet_jet_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"monojet_jet_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_jet_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_jet_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_dPhimetjet"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"monojet_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_dPhimetjet, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         // Leptons
-        addHist(hMap1D, h_channel+"monojet_lepton1_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"monojet_lepton2_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"monojet_lepton1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_lepton2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_lepton1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_lepton2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton1_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton2_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_mll, sysName, 150, 0., 300.);
         ////////////////////
         // VBF phasespace //
         ////////////////////
         // Jets
-        addHist(hMap1D, h_channel+"vbf_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"vbf_jet1_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet2_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet3_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet3_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet3_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet1_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet2_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet3_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_dRjj"+sysName, 25, 0., 5.);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj1"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj2"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj3"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dRjj, sysName, 25, 0., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj1, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj2, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj3, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         // Leptons
-        addHist(hMap1D, h_channel+"vbf_lepton1_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"vbf_lepton2_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"vbf_lepton1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_lepton2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_lepton1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_lepton2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton1_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton2_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_mll, sysName, 150, 0., 300.);
         ////////////////////
         // SM1 phasespace //
         ////////////////////
         // For publication
-        addHist(hMap1D, h_channel+"sm1_met_emulmet"+sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_met_emulmet, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_met_emulmet_cst, sysName, nbinMET, binsMET);
         // Jets
-        addHist(hMap1D, h_channel+"sm1_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"sm1_jet_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"sm1_jet_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_jet_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_jet_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_dPhimetjet"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"sm1_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_dPhimetjet, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         // Leptons
-        addHist(hMap1D, h_channel+"sm1_lepton1_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"sm1_lepton2_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"sm1_lepton1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_lepton2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_lepton1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_lepton2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton1_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton2_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_mll, sysName, 150, 0., 300.);
 
         //////////////////////////////////
         // MET Trigger Efficiency Study //
         //////////////////////////////////
-        addHist(hMap1D, h_channel+"vbf_eff_study_met_emulmet"+sysName, 250, 0., 500.);
-        addHist(hMap1D, h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70"+sysName, 250, 0., 500.);
-        addHist(hMap1D, h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70_tclcw"+sysName, 250, 0., 500.);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_allmet"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_allmet"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met130"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met130"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met150"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met150"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met200"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met200"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_met_emulmet, sysName, 250, 0., 500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70, sysName, 250, 0., 500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70_tclcw, sysName, 250, 0., 500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met130, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met150, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met200, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
       }
 
 
@@ -1060,27 +1462,27 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
       ////////////////////////
       // Monojet phasespace //
       ////////////////////////
-      addHist(hMap1D, h_channel+"monojet_multijet_study_mll_all_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_met_emulmet_all_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_mll_os_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_met_emulmet_os_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_mll_ss_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_met_emulmet_ss_lep"+sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_mll_all_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_all_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_mll_os_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_os_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_mll_ss_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_ss_lep, sysName, nbinMET, binsMET);
       ////////////////////
       // VBF phasespace //
       ////////////////////
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mll_all_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_met_emulmet_all_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mjj_all_lep"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_dPhijj_all_lep"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mll_os_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_met_emulmet_os_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mjj_os_lep"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_dPhijj_os_lep"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mll_ss_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_met_emulmet_ss_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mjj_ss_lep"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_dPhijj_ss_lep"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mll_all_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_all_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mjj_all_lep, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_all_lep, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mll_os_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_os_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mjj_os_lep, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_os_lep, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mll_ss_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_ss_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mjj_ss_lep, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_ss_lep, sysName, nbinDPhi, binsDPhi);
 
 
       // Multijet Background study (Method 2)
@@ -1092,34 +1494,34 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met500_inf_mll, sysName, 150, 0., 300.);
         ////////////////////
         // VBF phasespace //
         ////////////////////
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met500_inf_mll, sysName, 150, 0., 300.);
         //-----------//
         // Count cut //
         //-----------//
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met150_200_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met200_300_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met300_500_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met500_inf_count_mll"+sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met150_200_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met200_300_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met300_500_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met500_inf_count_mll, sysName, 16, 0.5, 16.5);
         ////////////////////
         // VBF phasespace //
         ////////////////////
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met150_200_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met200_300_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met300_500_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met500_inf_count_mll"+sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met150_200_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met200_300_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met300_500_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met500_inf_count_mll, sysName, 16, 0.5, 16.5);
         //-------------//
         // Reverse cut //
         //-------------//
@@ -1127,50 +1529,50 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
         // Monojet phasespace //
         ////////////////////////
         // Case 1
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 2
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 3
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met500_inf_mll, sysName, 150, 0., 300.);
         ////////////////////
         // VBF phasespace //
         ////////////////////
         // Case 1
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 2
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 3
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met500_inf_mll, sysName, 150, 0., 300.);
       }
 
       /////////////////////////////////
       // Truth Z -> mumu + JET EVENT //
       /////////////////////////////////
       if (!m_isData && sysName == "") {
-        addHist(hMap1D, h_channel+"truth_monojet_met_emulmet"+sysName, nbinMET, binsMET);
-        addHist(hMap1D, h_channel+"truth_monojet_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"truth_vbf_met_emulmet"+sysName, nbinMET, binsMET);
-        addHist(hMap1D, h_channel+"truth_vbf_mjj"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"truth_vbf_dPhijj"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"truth_vbf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegTruthMonojet, kVar_met_emulmet, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegTruthMonojet, kVar_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_met_emulmet, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_mjj, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_dPhijj, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_mll, sysName, 150, 0., 300.);
       }
 
     } // m_isZmumu
@@ -1179,107 +1581,110 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
 
 
     if (m_isZee) {
-      h_channel = "h_zee_";
+      m_histChannel = kChZee;
 
       // For Ratio plot
-      addHist(hMap1D, "Zee_MET_mono"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, "Zee_MET_search"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, "Zee_Mjj_search"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, "Zee_DeltaPhiAll"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, kChZee, kRegRatio, kVar_MET_mono, sysName, nbinMET, binsMET);
+      addHist(hMap1D, kChZee, kRegRatio, kVar_MET_search, sysName, nbinMET, binsMET);
+      addHist(hMap1D, kChZee, kRegRatio, kVar_Mjj_search, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, kChZee, kRegRatio, kVar_DeltaPhiAll, sysName, nbinDPhi, binsDPhi);
 
       // For publication
-      addHist(hMap1D, h_channel+"monojet_met_emulmet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met_emulmet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet_cst, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet_cst, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj, sysName, nbinDPhi, binsDPhi);
 
       // For Top enhanced control region
       // At least 1 bJet
-      addHist(hMap1D, h_channel+"monojet_met_emulmet_1bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met_emulmet_1bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj_1bJet"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj_1bJet"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet_1bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet_1bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj_1bJet, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj_1bJet, sysName, nbinDPhi, binsDPhi);
       // At least 2 bJet
-      addHist(hMap1D, h_channel+"monojet_met_emulmet_2bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_met_emulmet_2bJet"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_mjj_2bJet"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_dPhijj_2bJet"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_met_emulmet_2bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_met_emulmet_2bJet, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_mjj_2bJet, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhijj_2bJet, sysName, nbinDPhi, binsDPhi);
 
       // Number of Interactions
-      addHist(hMap1D, h_channel+"monojet_avg_interaction"+sysName, 40, 0., 40.);
-      addHist(hMap1D, h_channel+"vbf_avg_interaction"+sysName, 40, 0., 40.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_avg_interaction, sysName, 40, 0., 40.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_avg_interaction, sysName, 40, 0., 40.);
 
       if (sysName == ""){
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
         // Jets
-        addHist(hMap1D, h_channel+"monojet_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"monojet_jet_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"monojet_jet_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_jet_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_jet_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_dPhimetjet"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"monojet_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_jet_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_dPhimetjet, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         // Leptons
-        addHist(hMap1D, h_channel+"monojet_lepton1_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"monojet_lepton2_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"monojet_lepton1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_lepton2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"monojet_lepton1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_lepton2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"monojet_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton1_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton2_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_lepton2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_mll, sysName, 150, 0., 300.);
         ////////////////////
         // VBF phasespace //
         ////////////////////
         // Jets
-        addHist(hMap1D, h_channel+"vbf_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"vbf_jet1_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet2_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet3_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"vbf_jet1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet3_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_jet1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet3_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet1_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet2_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_jet3_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_dRjj"+sysName, 25, 0., 5.);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj1"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj2"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhimetj3"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"vbf_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet1_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet2_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_jet3_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dRjj, sysName, 25, 0., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj1, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj2, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhimetj3, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         // Leptons
-        addHist(hMap1D, h_channel+"vbf_lepton1_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"vbf_lepton2_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"vbf_lepton1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_lepton2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"vbf_lepton1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_lepton2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"vbf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton1_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton2_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_lepton2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_mll, sysName, 150, 0., 300.);
         ////////////////////
         // SM1 phasespace //
         ////////////////////
         // For publication
-        addHist(hMap1D, h_channel+"sm1_met_emulmet"+sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_met_emulmet, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_met_emulmet_cst, sysName, nbinMET, binsMET);
         // Jets
-        addHist(hMap1D, h_channel+"sm1_njet"+sysName, 40, 0., 40.);
-        addHist(hMap1D, h_channel+"sm1_jet_pt"+sysName, 60, 0., 3000.);
-        addHist(hMap1D, h_channel+"sm1_jet_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_jet_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_jet_rap"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_dPhimetjet"+sysName, 16, 0., 3.2);
-        addHist(hMap1D, h_channel+"sm1_dPhiMinmetjet"+sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_njet, sysName, 40, 0., 40.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_pt, sysName, 60, 0., 3000.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_jet_rap, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_dPhimetjet, sysName, 16, 0., 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_dPhiMinmetjet, sysName, 16, 0., 3.2);
         // Leptons
-        addHist(hMap1D, h_channel+"sm1_lepton1_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"sm1_lepton2_pt"+sysName, 30, 0., 1500.);
-        addHist(hMap1D, h_channel+"sm1_lepton1_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_lepton2_phi"+sysName, 32, -3.2, 3.2);
-        addHist(hMap1D, h_channel+"sm1_lepton1_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_lepton2_eta"+sysName, 25, -5., 5.);
-        addHist(hMap1D, h_channel+"sm1_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton1_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton2_pt, sysName, 30, 0., 1500.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton1_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton2_phi, sysName, 32, -3.2, 3.2);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton1_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_lepton2_eta, sysName, 25, -5., 5.);
+        addHist(hMap1D, m_histChannel, kRegSM1, kVar_mll, sysName, 150, 0., 300.);
       }
 
 
@@ -1288,27 +1693,27 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
       ////////////////////////
       // Monojet phasespace //
       ////////////////////////
-      addHist(hMap1D, h_channel+"monojet_multijet_study_mll_all_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_met_emulmet_all_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_mll_os_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_met_emulmet_os_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_mll_ss_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"monojet_multijet_study_met_emulmet_ss_lep"+sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_mll_all_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_all_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_mll_os_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_os_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_mll_ss_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_ss_lep, sysName, nbinMET, binsMET);
       ////////////////////
       // VBF phasespace //
       ////////////////////
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mll_all_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_met_emulmet_all_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mjj_all_lep"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_dPhijj_all_lep"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mll_os_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_met_emulmet_os_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mjj_os_lep"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_dPhijj_os_lep"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mll_ss_lep"+sysName, 150, 0., 300.);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_met_emulmet_ss_lep"+sysName, nbinMET, binsMET);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_mjj_ss_lep"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_multijet_study_dPhijj_ss_lep"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mll_all_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_all_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mjj_all_lep, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_all_lep, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mll_os_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_os_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mjj_os_lep, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_os_lep, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mll_ss_lep, sysName, 150, 0., 300.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_ss_lep, sysName, nbinMET, binsMET);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_mjj_ss_lep, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_ss_lep, sysName, nbinDPhi, binsDPhi);
 
 
       // Multijet Background study (Method 2)
@@ -1322,37 +1727,37 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met"+sysName, nbinMET_method2, binsMET_method2);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_nominal_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met, sysName, nbinMET_method2, binsMET_method2);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met500_inf_mll, sysName, 150, 0., 300.);
 
         ////////////////////
         // VBF phasespace //
         ////////////////////
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met"+sysName, nbinMET_method2, binsMET_method2);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_nominal_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met, sysName, nbinMET_method2, binsMET_method2);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met500_inf_mll, sysName, 150, 0., 300.);
         //-----------//
         // Count cut //
         //-----------//
         ////////////////////////
         // Monojet phasespace //
         ////////////////////////
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met150_200_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met200_300_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met300_500_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_met500_inf_count_mll"+sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met150_200_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met200_300_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met300_500_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_met500_inf_count_mll, sysName, 16, 0.5, 16.5);
         ////////////////////
         // VBF phasespace //
         ////////////////////
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met150_200_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met200_300_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met300_500_count_mll"+sysName, 16, 0.5, 16.5);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_met500_inf_count_mll"+sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met150_200_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met200_300_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met300_500_count_mll, sysName, 16, 0.5, 16.5);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_met500_inf_count_mll, sysName, 16, 0.5, 16.5);
         //-------------//
         // Reverse cut //
         //-------------//
@@ -1360,50 +1765,50 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
         // Monojet phasespace //
         ////////////////////////
         // Case 1
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case1_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 2
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case2_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 3
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"monojet_qcd_method2_case3_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met500_inf_mll, sysName, 150, 0., 300.);
         ////////////////////
         // VBF phasespace //
         ////////////////////
         // Case 1
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case1_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 2
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case2_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met500_inf_mll, sysName, 150, 0., 300.);
         // Case 3
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met150_200_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met200_300_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met300_500_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"vbf_qcd_method2_case3_cut_met500_inf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met150_200_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met200_300_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met300_500_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met500_inf_mll, sysName, 150, 0., 300.);
       }
 
       ///////////////////////////////
       // Truth Z -> ee + JET EVENT //
       ///////////////////////////////
       if (!m_isData && sysName == "") {
-        addHist(hMap1D, h_channel+"truth_monojet_met_emulmet"+sysName, nbinMET, binsMET);
-        addHist(hMap1D, h_channel+"truth_monojet_mll"+sysName, 150, 0., 300.);
-        addHist(hMap1D, h_channel+"truth_vbf_met_emulmet"+sysName, nbinMET, binsMET);
-        addHist(hMap1D, h_channel+"truth_vbf_mjj"+sysName, nbinMjj, binsMjj);
-        addHist(hMap1D, h_channel+"truth_vbf_dPhijj"+sysName, nbinDPhi, binsDPhi);
-        addHist(hMap1D, h_channel+"truth_vbf_mll"+sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegTruthMonojet, kVar_met_emulmet, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegTruthMonojet, kVar_mll, sysName, 150, 0., 300.);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_met_emulmet, sysName, nbinMET, binsMET);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_mjj, sysName, nbinMjj, binsMjj);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_dPhijj, sysName, nbinDPhi, binsDPhi);
+        addHist(hMap1D, m_histChannel, kRegTruthVBF, kVar_mll, sysName, 150, 0., 300.);
       }
 
     } // m_isZee
@@ -1415,35 +1820,35 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
     // MET Trigger Efficiency Study //
     //////////////////////////////////
     if (m_isWmunu && sysName == "") {
-      h_channel = "h_wmunu_";
+      m_histChannel = kChWmunu;
       // MET Trigger Efficiency Study
-      addHist(hMap1D, h_channel+"vbf_eff_study_met_emulmet"+sysName, 250, 0., 500.);
-      addHist(hMap1D, h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70"+sysName, 250, 0., 500.);
-      addHist(hMap1D, h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70_tclcw"+sysName, 250, 0., 500.);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_allmet"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_allmet"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met130"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met130"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met150"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met150"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met200"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met200"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70"+sysName, nbinDPhi, binsDPhi);
-      addHist(hMap1D, h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70_tclcw"+sysName, nbinMjj, binsMjj);
-      addHist(hMap1D, h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw"+sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_met_emulmet, sysName, 250, 0., 500.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70, sysName, 250, 0., 500.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70_tclcw, sysName, 250, 0., 500.);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met130, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met150, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met200, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70, sysName, nbinDPhi, binsDPhi);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70_tclcw, sysName, nbinMjj, binsMjj);
+      addHist(hMap1D, m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw, sysName, nbinDPhi, binsDPhi);
     }
 
 
@@ -1456,31 +1861,31 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
         ////////////////////////////
         // Before Overlap Removal //
         ////////////////////////////
-        addHist(hMap1D, "NTauBefore"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NEleBefore"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NMuBefore"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NMuZBefore"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NJetBefore"+sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NTauBefore, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NEleBefore, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NMuBefore, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NMuZBefore, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NJetBefore, sysName, 20, 0., 20.);
         ////////////////////////////
         // After Overlap Removal //
         ////////////////////////////
-        addHist(hMap1D, "NTauAfter"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NEleAfter"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NMuAfter"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NMuZAfter"+sysName, 20, 0., 20.);
-        addHist(hMap1D, "NJetAfter"+sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NTauAfter, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NEleAfter, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NMuAfter, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NMuZAfter, sysName, 20, 0., 20.);
+        addHist(hMap1D, kChInclusive, kRegNone, kVar_NJetAfter, sysName, 20, 0., 20.);
 
         ///////////////////////////////////
         // Basic distribution comparison //
         ///////////////////////////////////
-        addHist(hMap1D, "Emily_Zee_MET_mono"+sysName, 150,   0.,  1500.);
-        addHist(hMap1D, "Emily_Zee_MET_search"+sysName, 30,    0.0,  1500.);
-        addHist(hMap1D, "Emily_Zee_Mjj_search"+sysName, 80,    0.0,  4000.);
-        addHist(hMap1D, "Emily_Zee_DeltaPhiAll"+sysName, 100, 0, TMath::Pi());
-        addHist(hMap1D, "Emily_Zmumu_MET_mono"+sysName, 150,   0.,  1500.);
-        addHist(hMap1D, "Emily_Zmumu_MET_search"+sysName, 30,    0.0,  1500.);
-        addHist(hMap1D, "Emily_Zmumu_Mjj_search"+sysName, 80,    0.0,  4000.);
-        addHist(hMap1D, "Emily_Zmumu_DeltaPhiAll"+sysName, 100, 0, TMath::Pi());
+        addHist(hMap1D, kChZee, kRegEmily, kVar_MET_mono, sysName, 150,   0.,  1500.);
+        addHist(hMap1D, kChZee, kRegEmily, kVar_MET_search, sysName, 30,    0.0,  1500.);
+        addHist(hMap1D, kChZee, kRegEmily, kVar_Mjj_search, sysName, 80,    0.0,  4000.);
+        addHist(hMap1D, kChZee, kRegEmily, kVar_DeltaPhiAll, sysName, 100, 0, TMath::Pi());
+        addHist(hMap1D, kChZmumu, kRegEmily, kVar_MET_mono, sysName, 150,   0.,  1500.);
+        addHist(hMap1D, kChZmumu, kRegEmily, kVar_MET_search, sysName, 30,    0.0,  1500.);
+        addHist(hMap1D, kChZmumu, kRegEmily, kVar_Mjj_search, sysName, 80,    0.0,  4000.);
+        addHist(hMap1D, kChZmumu, kRegEmily, kVar_DeltaPhiAll, sysName, 100, 0, TMath::Pi());
       }
     }
 
@@ -1488,7 +1893,11 @@ EL::StatusCode ZinvxAODAnalysis :: initialize ()
 
   } // Systematic loop end
 
+  m_histRegistry->Freeze();
 
+  std::vector<int> weightSysHist;
+  for (const auto &weightSys : m_weightSystematics) weightSysHist.push_back(weightSys.hist);
+  m_histRegistry->SetWeightSystematics(weightSysHist);
 
 
   return EL::StatusCode::SUCCESS;
@@ -1569,7 +1978,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       return EL::StatusCode::SUCCESS; // go to next event
     }
   } // end if not MC
-  if (m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("GRL");
+  if (m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutGRL);
   if (m_useArrayCutflow) m_eventCutflow[1]+=1;
 
 
@@ -1589,7 +1998,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     } // end if event flags check
   } // end if the event is data
   m_numCleanEvents++;
-  if (m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("LAr_Tile_Core");
+  if (m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutLArTileCore);
   if (m_useArrayCutflow) m_eventCutflow[2]+=1;
 
 
@@ -1622,7 +2031,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
   }
   if (primVertex->nTrackParticles() < 2) return EL::StatusCode::SUCCESS;
 
-  if (m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("Primary vertex");
+  // Event quantities for the object selection (read once, not per object and systematic)
+  m_eventContext.Fill(eventInfo, primVertex, m_isData);
+
+  if (m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutPrimaryVertex);
   if (m_useArrayCutflow) m_eventCutflow[3]+=1;
 
 
@@ -1697,31 +2109,33 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
   // Create copy containers //
   ////////////////////////////
 
-  xAOD::JetContainer* m_goodJet = new xAOD::JetContainer(SG::VIEW_ELEMENTS); // This is really a DataVector<xAOD::Jet>
+  // The arena owns the containers of the event: they keep their capacity from
+  // the previous event, and the reset also frees what an early return left
+  m_eventArena->Reset();
 
-  xAOD::MuonContainer* m_goodMuon = new xAOD::MuonContainer(SG::VIEW_ELEMENTS);
-  xAOD::MuonContainer* m_goodMuonForZ = new xAOD::MuonContainer(SG::VIEW_ELEMENTS); // only For Z->mumu selections (goodMuonForZ are the non-isolated muons)
-  xAOD::MuonContainer* m_baselineMuon = new xAOD::MuonContainer(SG::VIEW_ELEMENTS);
+  xAOD::JetContainer* m_goodJet = m_eventArena->View<xAOD::JetContainer>(kArenaGoodJet); // This is really a DataVector<xAOD::Jet>
 
-  xAOD::ElectronContainer* m_goodElectron = new xAOD::ElectronContainer(SG::VIEW_ELEMENTS);
-  xAOD::ElectronContainer* m_baselineElectron = new xAOD::ElectronContainer(SG::VIEW_ELEMENTS);
+  xAOD::MuonContainer* m_goodMuon = m_eventArena->View<xAOD::MuonContainer>(kArenaGoodMuon);
+  xAOD::MuonContainer* m_goodMuonForZ = m_eventArena->View<xAOD::MuonContainer>(kArenaGoodMuonForZ); // only For Z->mumu selections (goodMuonForZ are the non-isolated muons)
+  xAOD::MuonContainer* m_baselineMuon = m_eventArena->View<xAOD::MuonContainer>(kArenaBaselineMuon);
 
-  xAOD::TauJetContainer* m_goodTau = new xAOD::TauJetContainer(SG::VIEW_ELEMENTS);
+  xAOD::ElectronContainer* m_goodElectron = m_eventArena->View<xAOD::ElectronContainer>(kArenaGoodElectron);
+  xAOD::ElectronContainer* m_baselineElectron = m_eventArena->View<xAOD::ElectronContainer>(kArenaBaselineElectron);
 
-  xAOD::PhotonContainer* m_goodPhoton = new xAOD::PhotonContainer(SG::VIEW_ELEMENTS);
+  xAOD::TauJetContainer* m_goodTau = m_eventArena->View<xAOD::TauJetContainer>(kArenaGoodTau);
 
-  // Create a MissingETContainer with its aux store for each systematic
-  xAOD::MissingETContainer* m_met = new xAOD::MissingETContainer();
-  xAOD::MissingETAuxContainer* m_metAux = new xAOD::MissingETAuxContainer();
-  m_met->setStore(m_metAux);
+  xAOD::PhotonContainer* m_goodPhoton = m_eventArena->View<xAOD::PhotonContainer>(kArenaGoodPhoton);
+
+  // MissingETContainer with its aux store, cleared for each systematic
+  xAOD::MissingETContainer* m_met = m_eventArena->Container<xAOD::MissingETContainer, xAOD::MissingETAuxContainer>(kArenaMET);
 
 
   // Create Truth Container
-  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthNeutrino = new ConstDataVector<xAOD::TruthParticleContainer>(SG::VIEW_ELEMENTS);
-  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthMuon = new ConstDataVector<xAOD::TruthParticleContainer>(SG::VIEW_ELEMENTS);
-  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthElectron = new ConstDataVector<xAOD::TruthParticleContainer>(SG::VIEW_ELEMENTS);
-  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthTau = new ConstDataVector<xAOD::TruthParticleContainer>(SG::VIEW_ELEMENTS);
-  ConstDataVector<xAOD::JetContainer> * m_selectedTruthJet = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthNeutrino = m_eventArena->View< ConstDataVector<xAOD::TruthParticleContainer> >(kArenaTruthNeutrino);
+  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthMuon = m_eventArena->View< ConstDataVector<xAOD::TruthParticleContainer> >(kArenaTruthMuon);
+  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthElectron = m_eventArena->View< ConstDataVector<xAOD::TruthParticleContainer> >(kArenaTruthElectron);
+  ConstDataVector<xAOD::TruthParticleContainer> * m_selectedTruthTau = m_eventArena->View< ConstDataVector<xAOD::TruthParticleContainer> >(kArenaTruthTau);
+  ConstDataVector<xAOD::JetContainer> * m_selectedTruthJet = m_eventArena->View< ConstDataVector<xAOD::JetContainer> >(kArenaTruthJet);
   //ConstDataVector<xAOD::JetContainer> * m_selectedTruthWZJet = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
 
 
@@ -1760,8 +2174,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
   float truth_dPhiMonojetMet_Zmumu = 0;
   float truth_dPhiMonojetMet_Zee = 0;
   // Dijet
-  TLorentzVector truth_jet1;
-  TLorentzVector truth_jet2;
+  FourVector truth_jet1;
+  FourVector truth_jet2;
   float truth_jet1_pt = 0;
   float truth_jet2_pt = 0;
   float truth_jet3_pt = 0;
@@ -1808,8 +2222,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
   float truth_dPhiMonoWZjetMet_Zmumu = 0;
   float truth_dPhiMonoWZjetMet_Zee = 0;
   // DiWZjet
-  TLorentzVector truth_WZjet1;
-  TLorentzVector truth_WZjet2;
+  FourVector truth_WZjet1;
+  FourVector truth_WZjet2;
   float truth_WZjet1_pt = 0;
   float truth_WZjet2_pt = 0;
   float truth_WZjet3_pt = 0;
@@ -1906,7 +2320,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Truth Neutinos
     //----------------
     /// shallow copy to retrive auxdata variables
-    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_neutrino_shallowCopy = xAOD::shallowCopyContainer( *m_truthNeutrinos );
+    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_neutrino_shallowCopy = m_eventArena->Adopt(xAOD::shallowCopyContainer( *m_truthNeutrinos ));
     xAOD::TruthParticleContainer* truth_neutrinoSC = truth_neutrino_shallowCopy.first;
 
     // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
@@ -1916,10 +2330,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       return StatusCode::FAILURE;
     }
 
-    TLorentzVector truthNeutrinoVector;
+    FourVector truthNeutrinoVector;
 
     for (const auto &neutrino : *truth_neutrinoSC) {
-      truthNeutrinoVector += neutrino->p4();
+      truthNeutrinoVector += FourVector(neutrino->px(), neutrino->py(), neutrino->pz(), neutrino->e());
       if (std::abs(neutrino->auxdata<int>("motherID")) < 111 && std::abs(neutrino->auxdata<int>("motherID")) != 15) {
         m_selectedTruthNeutrino->push_back(neutrino);
       }
@@ -1930,7 +2344,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Truth Muons
     //-------------
     /// shallow copy to retrive auxdata variables
-    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_muon_shallowCopy = xAOD::shallowCopyContainer( *m_truthMuons );
+    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_muon_shallowCopy = m_eventArena->Adopt(xAOD::shallowCopyContainer( *m_truthMuons ));
     xAOD::TruthParticleContainer* truth_muonSC = truth_muon_shallowCopy.first;
 
     // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
@@ -1942,12 +2356,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     for (const auto &muon : *truth_muonSC) {
       if (std::abs(muon->auxdata<int>("motherID")) < 111 && std::abs(muon->auxdata<int>("motherID")) != 15) {
-        TLorentzVector fourVector;
-        fourVector.SetPtEtaPhiE(muon->auxdata<float>("pt_dressed"), muon->auxdata<float>("eta_dressed"), muon->auxdata<float>("phi_dressed"), muon->auxdata<float>("e_dressed"));
-        muon->setE(fourVector.E());                
-        muon->setPx(fourVector.Px());
-        muon->setPy(fourVector.Py());
-        muon->setPz(fourVector.Pz());
+        FourVector fourVector = FourVector::PtEtaPhiE(muon->auxdata<float>("pt_dressed"), muon->auxdata<float>("eta_dressed"), muon->auxdata<float>("phi_dressed"), muon->auxdata<float>("e_dressed"));
+        muon->setE(fourVector.e);
+        muon->setPx(fourVector.px);
+        muon->setPy(fourVector.py);
+        muon->setPz(fourVector.pz);
         m_selectedTruthMuon->push_back(muon);
       }
     } 
@@ -1957,7 +2370,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Truth Electrons
     //-----------------
     /// shallow copy to retrive auxdata variables
-    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_elec_shallowCopy = xAOD::shallowCopyContainer( *m_truthElectrons );
+    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_elec_shallowCopy = m_eventArena->Adopt(xAOD::shallowCopyContainer( *m_truthElectrons ));
     xAOD::TruthParticleContainer* truth_elecSC = truth_elec_shallowCopy.first;
 
     // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
@@ -1970,12 +2383,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // iterate over our shallow copy
     for (const auto &electron : *truth_elecSC) {
       if (std::abs(electron->auxdata<int>("motherID")) < 111 && std::abs(electron->auxdata<int>("motherID")) != 15) {
-        TLorentzVector fourVector;
-        fourVector.SetPtEtaPhiE(electron->auxdata<float>("pt_dressed"), electron->auxdata<float>("eta_dressed"), electron->auxdata<float>("phi_dressed"), electron->auxdata<float>("e_dressed"));
-        electron->setE(fourVector.E());                
-        electron->setPx(fourVector.Px());
-        electron->setPy(fourVector.Py());
-        electron->setPz(fourVector.Pz());
+        FourVector fourVector = FourVector::PtEtaPhiE(electron->auxdata<float>("pt_dressed"), electron->auxdata<float>("eta_dressed"), electron->auxdata<float>("phi_dressed"), electron->auxdata<float>("e_dressed"));
+        electron->setE(fourVector.e);
+        electron->setPx(fourVector.px);
+        electron->setPy(fourVector.py);
+        electron->setPz(fourVector.pz);
         m_selectedTruthElectron->push_back(electron);
       }
     }
@@ -1985,7 +2397,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Truth Taus
     //------------
     /// shallow copy to retrive auxdata variables
-    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_tau_shallowCopy = xAOD::shallowCopyContainer( *m_truthTaus );
+    std::pair< xAOD::TruthParticleContainer*, xAOD::ShallowAuxContainer* > truth_tau_shallowCopy = m_eventArena->Adopt(xAOD::shallowCopyContainer( *m_truthTaus ));
     xAOD::TruthParticleContainer* truth_tauSC = truth_tau_shallowCopy.first;
 
     // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
@@ -2008,7 +2420,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Truth Jets
     //------------
     /// shallow copy to retrive auxdata variables
-    std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > truth_jet_shallowCopy = xAOD::shallowCopyContainer( *m_truthJets );
+    std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > truth_jet_shallowCopy = m_eventArena->Adopt(xAOD::shallowCopyContainer( *m_truthJets ));
     xAOD::JetContainer* truth_jetSC = truth_jet_shallowCopy.first;
 
     // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
@@ -2094,10 +2506,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Zmumu
     if (m_selectedTruthMuon->size() > 1) {
 
-      TLorentzVector truth_muon1 = m_selectedTruthMuon->at(0)->p4();
-      TLorentzVector truth_muon2 = m_selectedTruthMuon->at(1)->p4();
-      truth_muon1_pt = truth_muon1.Perp();
-      truth_muon2_pt = truth_muon2.Perp();
+      FourVector truth_muon1(m_selectedTruthMuon->at(0)->px(), m_selectedTruthMuon->at(0)->py(), m_selectedTruthMuon->at(0)->pz(), m_selectedTruthMuon->at(0)->e());
+      FourVector truth_muon2(m_selectedTruthMuon->at(1)->px(), m_selectedTruthMuon->at(1)->py(), m_selectedTruthMuon->at(1)->pz(), m_selectedTruthMuon->at(1)->e());
+      truth_muon1_pt = truth_muon1.Pt();
+      truth_muon2_pt = truth_muon2.Pt();
       auto truth_Zmumu = truth_muon1 + truth_muon2;
       truth_mll_muon = truth_Zmumu.M();
       m_truthEmulMETZmumu = truth_Zmumu.Pt();
@@ -2112,10 +2524,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Zee
     if (m_selectedTruthElectron->size() > 1) {
 
-      TLorentzVector truth_electron1 = m_selectedTruthElectron->at(0)->p4();
-      TLorentzVector truth_electron2 = m_selectedTruthElectron->at(1)->p4();
-      truth_electron1_pt = truth_electron1.Perp();
-      truth_electron2_pt = truth_electron2.Perp();
+      FourVector truth_electron1(m_selectedTruthElectron->at(0)->px(), m_selectedTruthElectron->at(0)->py(), m_selectedTruthElectron->at(0)->pz(), m_selectedTruthElectron->at(0)->e());
+      FourVector truth_electron2(m_selectedTruthElectron->at(1)->px(), m_selectedTruthElectron->at(1)->py(), m_selectedTruthElectron->at(1)->pz(), m_selectedTruthElectron->at(1)->e());
+      truth_electron1_pt = truth_electron1.Pt();
+      truth_electron2_pt = truth_electron2.Pt();
       auto truth_Zee = truth_electron1 + truth_electron2;
       truth_mll_electron = truth_Zee.M();
       m_truthEmulMETZee = truth_Zee.Pt();
@@ -2172,8 +2584,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     /////////////////////
     if (m_selectedTruthJet->size() > 1) {
 
-      truth_jet1 = m_selectedTruthJet->at(0)->p4();
-      truth_jet2 = m_selectedTruthJet->at(1)->p4();
+      truth_jet1 = FourVector::PtEtaPhiM(m_selectedTruthJet->at(0)->pt(), m_selectedTruthJet->at(0)->eta(), m_selectedTruthJet->at(0)->phi(), m_selectedTruthJet->at(0)->m());
+      truth_jet2 = FourVector::PtEtaPhiM(m_selectedTruthJet->at(1)->pt(), m_selectedTruthJet->at(1)->eta(), m_selectedTruthJet->at(1)->phi(), m_selectedTruthJet->at(1)->m());
       truth_jet1_pt = m_selectedTruthJet->at(0)->pt();
       truth_jet2_pt = m_selectedTruthJet->at(1)->pt();
       truth_jet1_phi = m_selectedTruthJet->at(0)->phi();
@@ -2314,8 +2726,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     /////////////////////
     if (m_selectedTruthJet->size() > 1) {
 
-      truth_WZjet1 = m_selectedTruthWZJet->at(0)->p4();
-      truth_WZjet2 = m_selectedTruthWZJet->at(1)->p4();
+      truth_WZjet1 = FourVector::PtEtaPhiM(m_selectedTruthWZJet->at(0)->pt(), m_selectedTruthWZJet->at(0)->eta(), m_selectedTruthWZJet->at(0)->phi(), m_selectedTruthWZJet->at(0)->m());
+      truth_WZjet2 = FourVector::PtEtaPhiM(m_selectedTruthWZJet->at(1)->pt(), m_selectedTruthWZJet->at(1)->eta(), m_selectedTruthWZJet->at(1)->phi(), m_selectedTruthWZJet->at(1)->m());
       truth_WZjet1_pt = m_selectedTruthWZJet->at(0)->pt();
       truth_WZjet2_pt = m_selectedTruthWZJet->at(1)->pt();
       truth_WZjet1_phi = m_selectedTruthWZJet->at(0)->phi();
@@ -2416,56 +2828,113 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
 
-    //////////////////////////////////
-    // Delete shallow copy containers
-    //////////////////////////////////
+    // The truth shallow copies are deleted by the event arena
 
-    // The containers created by the shallow copy are owned by you. Remember to delete them
-    delete truth_neutrino_shallowCopy.first;
-    delete truth_neutrino_shallowCopy.second;
+  } // MC
 
-    delete truth_muon_shallowCopy.first;
-    delete truth_muon_shallowCopy.second;
+  // End of Truth selection
 
-    delete truth_elec_shallowCopy.first;
-    delete truth_elec_shallowCopy.second;
 
-    delete truth_tau_shallowCopy.first;
-    delete truth_tau_shallowCopy.second;
 
-    delete truth_jet_shallowCopy.first;
-    delete truth_jet_shallowCopy.second;
+  //------------------------
+  // JETS (calibrated once)
+  //------------------------
+  // JES calibration does not depend on the systematic: calibrate once per event
+  // and let every systematic shallow-copy the calibrated jets. Only JES/JER
+  // variations re-apply the uncertainty tools (and JVT) on top of them.
+  std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > jetCalib_shallowCopy = m_eventArena->Adopt(xAOD::shallowCopyContainer( *m_jets ));
+  xAOD::JetContainer* jetCalibSC = jetCalib_shallowCopy.first;
 
-    //delete truth_WZjet_shallowCopy.first;
-    //delete truth_WZjet_shallowCopy.second;
+  for (const auto& jets : *jetCalibSC) { // C++11 shortcut
 
-  } // MC
+    // JES calibration
+    if ( !m_jetCalibration->applyCalibration(*jets).isSuccess() ){
+      Error("execute()", "Failed to apply calibration to Jet objects. Exiting." );
+      return EL::StatusCode::FAILURE;
+    }
 
-  // End of Truth selection
+    // JVT Tool (nominal)
+    acc_jvt(*jets) = m_jvtag->updateJvt(*jets);
 
+  } // end for loop over calibrated jets
 
 
 
+  // Object decisions of the previous event
+  m_decisionCache->Clear();
 
 
-  //-----------------------
-  // Systematics Start
-  //-----------------------
-  // loop over recommended systematics
-  for (const auto &sysList : m_sysList){
-    std::string sysName = (sysList).name();
-    if ((!m_doSys || m_isData) && sysName != "") continue;
 
-    if (m_doSys && (sysName.find("TAUS_")!=std::string::npos || sysName.find("PH_")!=std::string::npos )) continue;
-    if (m_isZmumu && !m_isZee && !m_isZnunu && m_doSys && ((sysName.find("EL_")!=std::string::npos || sysName.find("EG_")!=std::string::npos))) continue;
-    if (m_isZee && !m_isZmumu && !m_isZnunu && m_doSys && ((sysName.find("MUON_")!=std::string::npos || sysName.find("MUONS_")!=std::string::npos))) continue;
-    if (m_isZnunu && !m_isZmumu && !m_isZee && m_doSys && ((sysName.find("MUON_")!=std::string::npos || sysName.find("MUONS_")!=std::string::npos || sysName.find("EL_")!=std::string::npos || sysName.find("EG_")!=std::string::npos)) ) continue;
+  //------------------------------------
+  // Isolated tracks (once per event)
+  //------------------------------------
+  // The tracks do not depend on the systematic: fill the track grid and
+  // count the isolated tracks once, only the lepton matching is per systematic
+  int NisoTrackEvent = 0;
+  if (m_doIsoTrackVeto) {
+    // Retrieve main TrackParticle collection
+    const xAOD::TrackParticleContainer* inTracks(0);
+    if ( !m_event->retrieve( inTracks, "InDetTrackParticles" ).isSuccess() ){ // retrieve arguments: container type, container key
+      Error("execute()", "Failed to retrieve TrackParticle container. Exiting." );
+      return EL::StatusCode::FAILURE;
+    }
+    FillTrackSummary(inTracks, primVertex, 3.);
+    FillIsoTrackGrid();
+    NisoTrackEvent = NumIsoTracks(3., 10.);
+  }
 
-    //if (m_isZee && m_doSys && sysName.find("CorrUncertaintyNP")!=std::string::npos) continue; // Remove NP1~NP9, only choose Total error.
 
-    //if (m_isZmumu && m_doSys && sysName != "" &&  sysName != "MUON_EFF_SYS__1down" && sysName != "MUON_EFF_SYS__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1down") continue;
-    //if (m_isZee   && m_doSys && sysName != "" &&  sysName != "EL_EFF_ID_TotalCorrUncertainty__1down" && sysName != "EL_EFF_ID_TotalCorrUncertainty__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1down") continue
-    //if (m_isZnunu && m_doSys && sysName != "" &&  sysName != "JET_EtaIntercalibration_Modelling__1up" &&  sysName != "JET_EtaIntercalibration_Modelling__1down") continue;
+
+  //--------------------------
+  // Nominal results (reused)
+  //--------------------------
+  // Filled by the first pass that does not vary them (the nominal in slice 0)
+  // and reused by the systematics that do not affect them (see ActiveSystematic::dependencies)
+  std::pair< xAOD::MuonContainer*, xAOD::ShallowAuxContainer* > nominal_muons_shallowCopy(0, 0);
+  std::pair< xAOD::ElectronContainer*, xAOD::ShallowAuxContainer* > nominal_elec_shallowCopy(0, 0);
+  std::pair< xAOD::PhotonContainer*, xAOD::ShallowAuxContainer* > nominal_phot_shallowCopy(0, 0);
+  std::pair< xAOD::TauJetContainer*, xAOD::ShallowAuxContainer* > nominal_tau_shallowCopy(0, 0);
+  std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > nominal_jet_shallowCopy(0, 0);
+
+  struct {
+    bool valid = false;
+    float MET, MET_phi;
+    float emulMET_Wenu, emulMET_Wenu_phi;
+    float emulMET_Zee, emulMET_Zee_phi;
+    float emulMET_Wmunu, emulMET_Wmunu_phi;
+    float emulMET_Zmumu, emulMET_Zmumu_phi;
+    float MET_CST, emulMET_Zee_CST, emulMET_Zmumu_CST;
+  } nominalMET;
+
+  // Systematics envelope, evaluated once per event from its first pass
+  struct {
+    bool valid = false;
+    bool reachable = true;
+    float softTermShift = 0; ///MeV
+  } sysEnvelope;
+
+
+
+  //-----------------------
+  // Systematics Start
+  //-----------------------
+  // loop over the active systematics resolved in initialize()
+  // (weight-only systematics are filled from the nominal pass)
+  for (const auto &activeSys : m_selectionSystematics){
+    const CP::SystematicSet &sysList = m_sysList[activeSys.index];
+    const std::string &sysName = activeSys.name;
+    m_histSys = activeSys.hist;
+    // collections and weights varied by this systematic
+    const unsigned int sysDeps = activeSys.dependencies;
+    m_histRegistry->FillWeightSystematics(activeSys.isNominal);
+
+    // Systematic passes of events outside the envelope cannot reach any region
+    const bool envelopeSkip = sysEnvelope.valid && !sysEnvelope.reachable && !activeSys.isNominal;
+    if (envelopeSkip) {
+      m_numEnvelopeSkipped++;
+      if (!m_validateSysEnvelope) continue;
+    }
+    const unsigned long long numFillsBefore = m_histRegistry->NumFills();
 
     // Print the list of systematics
     //if(sysName=="") std::cout << "Nominal (no syst) "  << std::endl;
@@ -2474,78 +2943,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     if (!m_isData) {
 
-      if (m_jerSmearingTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure JERSmearingTool for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_jetUncertaintiesTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure JetUncertaintiesTool for systematics");
-        return EL::StatusCode::FAILURE; 
-      }
-      if (m_muonEfficiencySFTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure MuonEfficiencyScaleFactorsToolSF for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_muonIsolationSFTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure MuonIsolationEfficiencyScaleFactorsToolSF for systematics");
-        return EL::StatusCode::FAILURE; 
-      } 
-      if (m_muonTTVAEfficiencySFTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure MuonTTVAEfficiencyScaleFactorsToolSF for systematics");
-        return EL::StatusCode::FAILURE; 
-      } 
-      if (m_muonCalibrationAndSmearingTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure MuonCalibrationAndSmearingTool for systematics");
-        return EL::StatusCode::FAILURE;
-      } 
-      if (m_elecEfficiencySFTool_reco->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure electronEfficiencyCorrectionToolRecoSF for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_elecEfficiencySFTool_id_Loose->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure electronEfficiencyCorrectionToolIdLooseSF for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_elecEfficiencySFTool_id_Tight->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure electronEfficiencyCorrectionToolIdTightSF for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_elecEfficiencySFTool_iso_Loose->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure electronEfficiencyCorrectionToolIsoSFlooseID for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_elecEfficiencySFTool_iso_Tight->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure electronEfficiencyCorrectionToolIsoSFtightID for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_elecEfficiencySFTool_trigSF_Loose->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure electronEfficiencyCorrectionToolTriggerSFloose for systematics");
-        return EL::StatusCode::FAILURE;
-      }
-      if (m_egammaCalibrationAndSmearingTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure EgammaCalibrationAndSmearingTool for systematics");
-        return EL::StatusCode::FAILURE;
-      } 
-      if (m_isoCorrTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure IsolationCorrectionTool for systematics");
-        return EL::StatusCode::FAILURE;
-      } 
-      if (m_tauEffTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure TauEfficiencyCorrectionsTool for systematics");
-        return EL::StatusCode::FAILURE;
-      } 
-      if (m_tauSmearingTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure TauSmearingTool for systematics");
-        return EL::StatusCode::FAILURE;
-      } 
-      if (m_metSystTool->applySystematicVariation( sysList ) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure METSystematicsTool for systematics");
-        return EL::StatusCode::FAILURE;
-      }   
-      if (m_prwTool->applySystematicVariation( sysList ) != CP::SystematicCode::Ok) {
-        Error("execute()", "Cannot configure PileupReweightingTool for systematics");
-        return EL::StatusCode::FAILURE;
+      // Only reconfigure the tools affected by this systematic, plus the ones
+      // still set to a previous variation that have to go back to nominal
+      for (unsigned int t = 0; t < m_systematicsTools.size(); t++) {
+        const unsigned int toolBit = 1u << t;
+        m_numToolSwitchesAll++;
+        if (!((activeSys.tools | m_variedTools) & toolBit)) continue;
+        m_numToolSwitches++;
+        if (m_systematicsTools[t].tool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
+          Error("execute()", "Cannot configure %s for systematics", m_systematicsTools[t].name.c_str());
+          return EL::StatusCode::FAILURE;
+        }
       }
+      m_variedTools = activeSys.tools;
 
     }
 
@@ -2557,6 +2967,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //---------------------
     // Pile-up reweighting
     //---------------------
+    bool usePileupWeight = false;
     if (!m_isData) {
       if ( mcChannelNumber == 363121 || mcChannelNumber == 363351 || // One of the Ztautau or Wtaunu (from Valentinos)
            (mcChannelNumber >= 361063 && mcChannelNumber <= 361068) || mcChannelNumber == 361088 || mcChannelNumber == 361089 || // Diboson samples
@@ -2569,6 +2980,27 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
         float pu_weight = m_prwTool->getCombinedWeight(*eventInfo); // Get Pile-up weight
         print_puweight = pu_weight;
         mcEventWeight = mcWeight * pu_weight;
+        usePileupWeight = true;
+      }
+    }
+
+    // Event weight of the weight-only systematics filled from this pass
+    if (m_histRegistry->FillingWeightSystematics()) {
+      for (unsigned int i = 0; i < m_weightSystematics.size(); i++) {
+        const ActiveSystematic &weightSys = m_weightSystematics[i];
+        float weight = mcEventWeight;
+        if (usePileupWeight && (weightSys.dependencies & kSysPileupWeight)) {
+          if (m_prwTool->applySystematicVariation(m_sysList[weightSys.index]) != CP::SystematicCode::Ok) {
+            Error("execute()", "Cannot configure PileupReweightingTool for systematics");
+            return EL::StatusCode::FAILURE;
+          }
+          weight = mcWeight * m_prwTool->getCombinedWeight(*eventInfo);
+          if (m_prwTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
+            Error("execute()", "Cannot configure PileupReweightingTool for systematics");
+            return EL::StatusCode::FAILURE;
+          }
+        }
+        m_histRegistry->SetWeightVariation(kWeightEvent, i, weight);
       }
     }
 
@@ -2594,14 +3026,14 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Average Interaction
     float m_AverageInteractionsPerCrossing = 0.;
     if (!m_isData) {
-      m_AverageInteractionsPerCrossing = eventInfo->averageInteractionsPerCrossing();
+      m_AverageInteractionsPerCrossing = m_eventContext.averageInteractionsPerCrossing;
     }
     else {
       m_AverageInteractionsPerCrossing = m_prwTool->getCorrectedMu(*eventInfo, true);
     }
 
     if (sysName == ""){
-      hMap1D["avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight);
+      m_histRegistry->Fill(kChInclusive, kRegNone, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight, kWeightEvent);
     }
 
 
@@ -2614,23 +3046,35 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //------------
     /// shallow copy for muon calibration and smearing tool
     // create a shallow copy of the muons container for MET building
-    std::pair< xAOD::MuonContainer*, xAOD::ShallowAuxContainer* > muons_shallowCopy = xAOD::shallowCopyContainer( *m_muons );
-    xAOD::MuonContainer* muonSC = muons_shallowCopy.first;
+    // (the nominal copy is reused when this systematic does not affect muons)
+    const unsigned int copyMuons = (sysDeps & kSysMuons) ? kCopyVariedMuons : kCopyNominalMuons;
+    m_muonFlags = &m_copyFlags[copyMuons];
+    std::pair< xAOD::MuonContainer*, xAOD::ShallowAuxContainer* > muons_shallowCopy = nominal_muons_shallowCopy;
+    if (!muons_shallowCopy.first || (sysDeps & kSysMuons)) {
+      // the varied passes share one copy, reset to the input values (links and aux store are kept)
+      bool reusedMuons = false;
+      muons_shallowCopy = m_eventArena->ShallowCopy(copyMuons, *m_muons, reusedMuons);
+      xAOD::MuonContainer* muonSC = muons_shallowCopy.first;
+      m_muonFlags->Reset(muonSC->size());
+
+      // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
+      // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
+      // The method is defined in the header file xAODBase/IParticleHelpers.h
+      bool setLinksMuon = reusedMuons || xAOD::setOriginalObjectLink(*m_muons,*muonSC);
+      if(!setLinksMuon) {
+        Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
+        return StatusCode::FAILURE;
+      }
+      // iterate over our shallow copy
+      for (const auto& muon : *muonSC) { // C++11 shortcut
+        // VBF Muon Selection
+        passMuonVBF(*muon, m_eventContext);
+        //Info("execute()", "  VBF muon pt = %.2f GeV", (muon->pt() * 0.001));
+      } // end for loop over shallow copied muons
 
-    // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
-    // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
-    // The method is defined in the header file xAODBase/IParticleHelpers.h
-    bool setLinksMuon = xAOD::setOriginalObjectLink(*m_muons,*muonSC);
-    if(!setLinksMuon) {
-      Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
-      return StatusCode::FAILURE;
+      if (!(sysDeps & kSysMuons)) nominal_muons_shallowCopy = muons_shallowCopy;
     }
-    // iterate over our shallow copy
-    for (const auto& muon : *muonSC) { // C++11 shortcut
-      // VBF Muon Selection
-      passMuonVBF(*muon, eventInfo, primVertex);
-      //Info("execute()", "  VBF muon pt = %.2f GeV", (muon->pt() * 0.001));
-    } // end for loop over shallow copied muons
+    xAOD::MuonContainer* muonSC = muons_shallowCopy.first;
 
 
 
@@ -2639,23 +3083,35 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //------------
     /// shallow copy for electron calibration tool
     // create a shallow copy of the electrons container for MET building
-    std::pair< xAOD::ElectronContainer*, xAOD::ShallowAuxContainer* > elec_shallowCopy = xAOD::shallowCopyContainer( *m_electrons );
-    xAOD::ElectronContainer* elecSC = elec_shallowCopy.first;
+    // (the nominal copy is reused when this systematic does not affect electrons)
+    const unsigned int copyElectrons = (sysDeps & kSysElectrons) ? kCopyVariedElectrons : kCopyNominalElectrons;
+    m_elecFlags = &m_copyFlags[copyElectrons];
+    std::pair< xAOD::ElectronContainer*, xAOD::ShallowAuxContainer* > elec_shallowCopy = nominal_elec_shallowCopy;
+    if (!elec_shallowCopy.first || (sysDeps & kSysElectrons)) {
+      // the varied passes share one copy, reset to the input values (links and aux store are kept)
+      bool reusedElectrons = false;
+      elec_shallowCopy = m_eventArena->ShallowCopy(copyElectrons, *m_electrons, reusedElectrons);
+      xAOD::ElectronContainer* elecSC = elec_shallowCopy.first;
+      m_elecFlags->Reset(elecSC->size());
+
+      // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
+      // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
+      // The method is defined in the header file xAODBase/IParticleHelpers.h
+      bool setLinksElec = reusedElectrons || xAOD::setOriginalObjectLink(*m_electrons,*elecSC);
+      if(!setLinksElec) {
+        Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
+        return StatusCode::FAILURE;
+      }
+      // iterate over our shallow copy
+      for (const auto& electron : *elecSC) { // C++11 shortcut
+        // VBF Electron Selection
+        passElectronVBF(*electron, m_eventContext);
+        //Info("execute()", "  VBF electron pt = %.2f GeV", (electron->pt() * 0.001));
+      } // end for loop over shallow copied electrons
 
-    // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
-    // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
-    // The method is defined in the header file xAODBase/IParticleHelpers.h
-    bool setLinksElec = xAOD::setOriginalObjectLink(*m_electrons,*elecSC);
-    if(!setLinksElec) {
-      Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
-      return StatusCode::FAILURE;
+      if (!(sysDeps & kSysElectrons)) nominal_elec_shallowCopy = elec_shallowCopy;
     }
-    // iterate over our shallow copy
-    for (const auto& electron : *elecSC) { // C++11 shortcut
-      // VBF Electron Selection
-      passElectronVBF(*electron, eventInfo, primVertex);
-      //Info("execute()", "  VBF electron pt = %.2f GeV", (electron->pt() * 0.001));
-    } // end for loop over shallow copied electrons
+    xAOD::ElectronContainer* elecSC = elec_shallowCopy.first;
 
 
 
@@ -2664,22 +3120,34 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //------------
     /// shallow copy for photon calibration tool
     // create a shallow copy of the photons container for MET building
-    std::pair< xAOD::PhotonContainer*, xAOD::ShallowAuxContainer* > phot_shallowCopy = xAOD::shallowCopyContainer( *m_photons );
-    xAOD::PhotonContainer* photSC = phot_shallowCopy.first;
+    // (the nominal copy is reused when this systematic does not affect photons)
+    const unsigned int copyPhotons = (sysDeps & kSysPhotons) ? kCopyVariedPhotons : kCopyNominalPhotons;
+    m_photFlags = &m_copyFlags[copyPhotons];
+    std::pair< xAOD::PhotonContainer*, xAOD::ShallowAuxContainer* > phot_shallowCopy = nominal_phot_shallowCopy;
+    if (!phot_shallowCopy.first || (sysDeps & kSysPhotons)) {
+      // the varied passes share one copy, reset to the input values (links and aux store are kept)
+      bool reusedPhotons = false;
+      phot_shallowCopy = m_eventArena->ShallowCopy(copyPhotons, *m_photons, reusedPhotons);
+      xAOD::PhotonContainer* photSC = phot_shallowCopy.first;
+      m_photFlags->Reset(photSC->size());
+
+      // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
+      // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
+      // The method is defined in the header file xAODBase/IParticleHelpers.h
+      bool setLinksPhoton = reusedPhotons || xAOD::setOriginalObjectLink(*m_photons,*photSC);
+      if(!setLinksPhoton) {
+        Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
+        return StatusCode::FAILURE;
+      }
+      // iterate over our shallow copy
+      for (const auto& photon : *photSC) { // C++11 shortcut
+        // VBF Tau Selection
+        passPhotonVBF(*photon, m_eventContext);
+      } // end for loop over shallow copied photons
 
-    // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
-    // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
-    // The method is defined in the header file xAODBase/IParticleHelpers.h
-    bool setLinksPhoton = xAOD::setOriginalObjectLink(*m_photons,*photSC);
-    if(!setLinksPhoton) {
-      Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
-      return StatusCode::FAILURE;
+      if (!(sysDeps & kSysPhotons)) nominal_phot_shallowCopy = phot_shallowCopy;
     }
-    // iterate over our shallow copy
-    for (const auto& photon : *photSC) { // C++11 shortcut
-      // VBF Tau Selection
-      passPhotonVBF(*photon, eventInfo); 
-    } // end for loop over shallow copied photons
+    xAOD::PhotonContainer* photSC = phot_shallowCopy.first;
 
 
 
@@ -2688,83 +3156,98 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //------------
     /// shallow copy for tau calibration tool
     // create a shallow copy of the taus container for MET building
-    std::pair< xAOD::TauJetContainer*, xAOD::ShallowAuxContainer* > tau_shallowCopy = xAOD::shallowCopyContainer( *m_taus );
-    xAOD::TauJetContainer* tauSC = tau_shallowCopy.first;
+    // (the nominal copy is reused when this systematic does not affect taus)
+    const unsigned int copyTaus = (sysDeps & kSysTaus) ? kCopyVariedTaus : kCopyNominalTaus;
+    m_tauFlags = &m_copyFlags[copyTaus];
+    std::pair< xAOD::TauJetContainer*, xAOD::ShallowAuxContainer* > tau_shallowCopy = nominal_tau_shallowCopy;
+    if (!tau_shallowCopy.first || (sysDeps & kSysTaus)) {
+      // the varied passes share one copy, reset to the input values (links and aux store are kept)
+      bool reusedTaus = false;
+      tau_shallowCopy = m_eventArena->ShallowCopy(copyTaus, *m_taus, reusedTaus);
+      xAOD::TauJetContainer* tauSC = tau_shallowCopy.first;
+      m_tauFlags->Reset(tauSC->size());
+
+      // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
+      // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
+      // The method is defined in the header file xAODBase/IParticleHelpers.h
+      bool setLinksTau = reusedTaus || xAOD::setOriginalObjectLink(*m_taus,*tauSC);
+      if(!setLinksTau) {
+        Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
+        return StatusCode::FAILURE;
+      }
+      // iterate over our shallow copy
+      for (const auto& taujet : *tauSC) { // C++11 shortcut
+        // TauOverlappingElectronLLHDecorator
+        m_tauOverlappingElectronLLHDecorator->decorate(*taujet);
+        // VBF Tau Selection
+        passTauVBF(*taujet, m_eventContext);
+      } // end for loop over shallow copied taus
 
-    // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
-    // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
-    // The method is defined in the header file xAODBase/IParticleHelpers.h
-    bool setLinksTau = xAOD::setOriginalObjectLink(*m_taus,*tauSC);
-    if(!setLinksTau) {
-      Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
-      return StatusCode::FAILURE;
+      if (!(sysDeps & kSysTaus)) nominal_tau_shallowCopy = tau_shallowCopy;
     }
-    // iterate over our shallow copy
-    for (const auto& taujet : *tauSC) { // C++11 shortcut
-      // TauOverlappingElectronLLHDecorator
-      m_tauOverlappingElectronLLHDecorator->decorate(*taujet);
-      // VBF Tau Selection
-      passTauVBF(*taujet, eventInfo);
-    } // end for loop over shallow copied taus
+    xAOD::TauJetContainer* tauSC = tau_shallowCopy.first;
 
 
 
     //------------
     // JETS
     //------------
-    /// shallow copy for jet calibration tool
+    /// shallow copy of the calibrated jets
     // create a shallow copy of the jets container for MET building
-    std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > jet_shallowCopy = xAOD::shallowCopyContainer( *m_jets );
-    xAOD::JetContainer* jetSC = jet_shallowCopy.first;
-
-    // iterate over our shallow copy
-    for (const auto& jets : *jetSC) { // C++11 shortcut
-      //Info("execute()", "  original jet pt = %.2f GeV", jets->pt() * 0.001);
-
-      // According to https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/JetEtmissRecommendationsMC15
-
-      // JES calibration
-      if ( !m_jetCalibration->applyCalibration(*jets).isSuccess() ){
-        Error("execute()", "Failed to apply calibration to Jet objects. Exiting." );
-        return EL::StatusCode::FAILURE;
-      }
+    // (the nominal copy is reused when this systematic does not affect jets)
+    const unsigned int copyJets = (sysDeps & kSysJets) ? kCopyVariedJets : kCopyNominalJets;
+    m_jetFlags = &m_copyFlags[copyJets];
+    std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > jet_shallowCopy = nominal_jet_shallowCopy;
+    if (!jet_shallowCopy.first || (sysDeps & kSysJets)) {
+      // the varied passes share one copy, reset to the input values (links and aux store are kept)
+      bool reusedJets = false;
+      jet_shallowCopy = m_eventArena->ShallowCopy(copyJets, *jetCalibSC, reusedJets);
+      xAOD::JetContainer* jetSC = jet_shallowCopy.first;
+      m_jetFlags->Reset(jetSC->size());
+
+      // JES/JER are no-ops for systematics that do not affect jets (no nominal smearing)
+      const bool varyJets = !m_isData && (sysDeps & kSysJets);
+
+      // iterate over our shallow copy
+      for (const auto& jets : *jetSC) { // C++11 shortcut
+        //Info("execute()", "  calibrated jet pt = %.2f GeV", jets->pt() * 0.001);
+
+        // According to https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/JetEtmissRecommendationsMC15
+
+        if (varyJets){
+          // JES correction
+          if ( m_jetUncertaintiesTool->applyCorrection(*jets) != CP::CorrectionCode::Ok){ // apply correction and check return code
+            Error("execute()", "Failed to apply JES correction to Jet objects. Exiting." );
+            return EL::StatusCode::FAILURE;
+          }
 
-      // JES correction
-      if (!m_isData){
-        if ( m_jetUncertaintiesTool->applyCorrection(*jets) != CP::CorrectionCode::Ok){ // apply correction and check return code
-          Error("execute()", "Failed to apply JES correction to Jet objects. Exiting." );
-          return EL::StatusCode::FAILURE;
-        }
-      }
+          // JER smearing
+          if ( m_jerSmearingTool->applyCorrection(*jets) != CP::CorrectionCode::Ok){ // apply correction and check return code
+            Error("execute()", "Failed to apply JER smearing. Exiting. ");
+            return EL::StatusCode::FAILURE;
+          }
 
-      // JER smearing
-      if (!m_isData){
-        if ( m_jerSmearingTool->applyCorrection(*jets) != CP::CorrectionCode::Ok){ // apply correction and check return code
-          Error("execute()", "Failed to apply JER smearing. Exiting. ");
-          return EL::StatusCode::FAILURE;
+          // JVT Tool
+          float newjvt = m_jvtag->updateJvt(*jets);
+          acc_jvt(*jets) = newjvt;
         }
-      }
 
-      // JVT Tool
-      float newjvt = m_jvtag->updateJvt(*jets);
-      acc_jvt(*jets) = newjvt;
+        //Info("execute()", "  corrected jet pt = %.2f GeV", jets->pt() * 0.001);
 
-      //Info("execute()", "  corrected jet pt = %.2f GeV", jets->pt() * 0.001);
-      //Info("execute()", "  updated jet jvt = %.2f ", newjvt);
+      } // end for loop over shallow copied jets
 
-      dec_signal(*jets) = false;
-      selectDec(*jets) = false; // To select objects for Overlap removal
-
-    } // end for loop over shallow copied jets
+      // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
+      // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
+      // The method is defined in the header file xAODBase/IParticleHelpers.h
+      bool setLinksJet = reusedJets || xAOD::setOriginalObjectLink(*m_jets,*jetSC);
+      if(!setLinksJet) {
+        Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
+        return StatusCode::FAILURE;
+      }
 
-    // Decorate objects with ElementLink to their originals -- this is needed to retrieve the contribution of each object to the MET terms.
-    // You should make sure that you use the tag xAODBase-00-00-22, which is available from AnalysisBase-2.0.11.
-    // The method is defined in the header file xAODBase/IParticleHelpers.h
-    bool setLinksJet = xAOD::setOriginalObjectLink(*m_jets,*jetSC);
-    if(!setLinksJet) {
-      Error("execute()", "Failed to set original object links -- MET rebuilding cannot proceed.");
-      return StatusCode::FAILURE;
+      if (!(sysDeps & kSysJets)) nominal_jet_shallowCopy = jet_shallowCopy;
     }
+    xAOD::JetContainer* jetSC = jet_shallowCopy.first;
 
 
 
@@ -2776,15 +3259,18 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     bool isBadJet = false;
 
+    for (unsigned int i = 0; i < kNumLeadingCollections; i++) m_leadingObjects[i].Clear();
+
     // iterate over our shallow copy
     for (const auto& jets : *jetSC) { // C++11 shortcut
 
       // Jet Signal Selection
       if (IsSignalJet(*jets)) {
 
-        m_goodJet->push_back( jets );
+        m_leadingObjects[kLeadGoodJet].Add( jets );
       }
     } // end for loop over shallow copied jets
+    m_leadingObjects[kLeadGoodJet].Fill(*m_goodJet);
 
 
 
@@ -2798,18 +3284,21 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // iterate over our shallow copy
     for (const auto& muon : *muonSC) { // C++11 shortcut
       // Muon Selection for VBF study
-      if (dec_signal(*muon)) {
-        m_goodMuon->push_back( muon );
+      if (m_muonFlags->Get(kObjSignal, muon->index())) {
+        m_leadingObjects[kLeadGoodMuon].Add( muon );
         //Info("execute()", "  Good muon pt = %.2f GeV", (muon->pt() * 0.001));
       }
-      if (dec_signal_forZ(*muon)) {
+      if (m_muonFlags->Get(kObjSignalForZ, muon->index())) {
         muon->auxdata<bool>("brem") = false; // For overlap removal with electron
-        m_goodMuonForZ->push_back( muon );
+        m_leadingObjects[kLeadGoodMuonForZ].Add( muon );
       }
-      if (dec_baseline(*muon)) {
-        m_baselineMuon->push_back( muon ); // For QCD multijet study
+      if (m_muonFlags->Get(kObjBaseline, muon->index())) {
+        m_leadingObjects[kLeadBaselineMuon].Add( muon ); // For QCD multijet study
       }
     } // end for loop over shallow copied muons
+    m_leadingObjects[kLeadGoodMuon].Fill(*m_goodMuon);
+    m_leadingObjects[kLeadGoodMuonForZ].Fill(*m_goodMuonForZ);
+    m_leadingObjects[kLeadBaselineMuon].Fill(*m_baselineMuon);
 
     ///////////////////
     // Good Electron //
@@ -2817,13 +3306,15 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // iterate over our shallow copy
     for (const auto& electron : *elecSC) { // C++11 shortcut
       // Electron Selection for VBF study
-      if (dec_signal(*electron)) {
-          m_goodElectron->push_back( electron );
+      if (m_elecFlags->Get(kObjSignal, electron->index())) {
+          m_leadingObjects[kLeadGoodElectron].Add( electron );
       }
-      if (dec_baseline(*electron)) {
-        m_baselineElectron->push_back( electron ); // For QCD multijet study
+      if (m_elecFlags->Get(kObjBaseline, electron->index())) {
+        m_leadingObjects[kLeadBaselineElectron].Add( electron ); // For QCD multijet study
       }
     } // end for loop over shallow copied electrons
+    m_leadingObjects[kLeadGoodElectron].Fill(*m_goodElectron);
+    m_leadingObjects[kLeadBaselineElectron].Fill(*m_baselineElectron);
 
     //////////////
     // Good Tau //
@@ -2831,7 +3322,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // iterate over our shallow copy
     for (const auto& taujet : *tauSC) { // C++11 shortcut
       // Tau Selection for VBF study
-      if (dec_signal(*taujet)) {
+      if (m_tauFlags->Get(kObjSignal, taujet->index())) {
         m_goodTau->push_back( taujet );
         //Info("execute()", "  Good tau pt = %.2f GeV", (taujet->pt() * 0.001));
       }
@@ -2843,7 +3334,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // iterate over our shallow copy
     for (const auto& photon : *photSC) { // C++11 shortcut
       // Photon Selection for VBF study
-      if (dec_signal(*photon)) {
+      if (m_photFlags->Get(kObjSignal, photon->index())) {
         m_goodPhoton->push_back( photon );
       }
     } // end for loop over shallow copied photons
@@ -2852,24 +3343,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
 
-    /////////////////////////////////
-    // Sort Good Muon and Electron //
-    /////////////////////////////////
-    /*
-    // Muon
-    if (m_goodMuon->size() > 1) std::sort(m_goodMuon->begin(), m_goodMuon->end(), DescendingPt());
-    if (m_goodMuonForZ->size() > 1) std::sort(m_goodMuonForZ->begin(), m_goodMuonForZ->end(), DescendingPt());
-    if (m_baselineMuon->size() > 1) std::sort(m_baselineMuon->begin(), m_baselineMuon->end(), DescendingPt());
-    // Electron
-    if (m_goodElectron->size() > 1) std::sort(m_goodElectron->begin(), m_goodElectron->end(), DescendingPt());
-    if (m_baselineElectron->size() > 1) std::sort(m_baselineElectron->begin(), m_baselineElectron->end(), DescendingPt());
-    */
-
-    if (m_goodMuonForZ->size() > 1) std::partial_sort(m_goodMuonForZ->begin(), m_goodMuonForZ->begin()+2, m_goodMuonForZ->end(), DescendingPt());
-    if (m_goodMuon->size() > 1) std::partial_sort(m_goodMuon->begin(), m_goodMuon->begin()+2, m_goodMuon->end(), DescendingPt());
-    if (m_baselineMuon->size() > 1) std::partial_sort(m_baselineMuon->begin(), m_baselineMuon->begin()+2, m_baselineMuon->end(), DescendingPt());
-    if (m_goodElectron->size() > 1) std::partial_sort(m_goodElectron->begin(), m_goodElectron->begin()+2, m_goodElectron->end(), DescendingPt());
-    if (m_baselineElectron->size() > 1) std::partial_sort(m_baselineElectron->begin(), m_baselineElectron->begin()+2, m_baselineElectron->end(), DescendingPt());
+    // The good muons and electrons start with their two leading objects in pt
+    // (m_leadingObjects): the overlap removal below erases without reordering
 
 
 
@@ -2878,6 +3353,13 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Decorate overlapped objects using official OR Tool
     //----------------------------------------------------
 
+    // The overlap removal reads its input selection from the objects
+    for (const auto& electron : *m_goodElectron) selectDec(*electron) = m_elecFlags->Get(kObjSelected, electron->index());
+    for (const auto& muon : *m_goodMuon) selectDec(*muon) = m_muonFlags->Get(kObjSelected, muon->index());
+    for (const auto& jet : *m_goodJet) selectDec(*jet) = m_jetFlags->Get(kObjSelected, jet->index());
+    for (const auto& taujet : *m_goodTau) selectDec(*taujet) = m_tauFlags->Get(kObjSelected, taujet->index());
+    for (const auto& photon : *m_goodPhoton) selectDec(*photon) = m_photFlags->Get(kObjSelected, photon->index());
+
     if ( !m_orTool->removeOverlaps(m_goodElectron, m_goodMuon, m_goodJet, m_goodTau, m_goodPhoton).isSuccess() ){
       Error("execute()", "Failed to apply the overlap removal to all objects. Exiting." );
       return EL::StatusCode::FAILURE;
@@ -2929,11 +3411,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     ////////////////////////////
     if (m_isEmilyCutflow && sysName == "") {
       if ( (m_isZee || m_isZmumu) ){
-        hMap1D["NTauBefore"+sysName]->Fill(m_goodTau->size(),1.0);
-        hMap1D["NEleBefore"+sysName]->Fill(m_goodElectron->size(),1.0);
-        hMap1D["NMuBefore"+sysName]->Fill(m_goodMuon->size(),1.0);
-        hMap1D["NMuZBefore"+sysName]->Fill(m_goodMuonForZ->size(),1.0);
-        hMap1D["NJetBefore"+sysName]->Fill(m_goodJet->size(),1.0);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NTauBefore, m_histSys, m_goodTau->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NEleBefore, m_histSys, m_goodElectron->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NMuBefore, m_histSys, m_goodMuon->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NMuZBefore, m_histSys, m_goodMuonForZ->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NJetBefore, m_histSys, m_goodJet->size(),1.0, kWeightUnit);
         /*
         if (m_goodMuonForZ->size() != m_goodMuon->size()){
           Info("execute()", "============================");
@@ -3074,11 +3556,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     ////////////////////////////
     if (m_isEmilyCutflow && sysName == "") {
       if ( (m_isZee || m_isZmumu) ){
-        hMap1D["NTauAfter"+sysName]->Fill(m_goodTau->size(),1.0);
-        hMap1D["NEleAfter"+sysName]->Fill(m_goodElectron->size(),1.0);
-        hMap1D["NMuAfter"+sysName]->Fill(m_goodMuon->size(),1.0);
-        hMap1D["NMuZAfter"+sysName]->Fill(m_goodMuonForZ->size(),1.0);
-        hMap1D["NJetAfter"+sysName]->Fill(m_goodJet->size(),1.0);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NTauAfter, m_histSys, m_goodTau->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NEleAfter, m_histSys, m_goodElectron->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NMuAfter, m_histSys, m_goodMuon->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NMuZAfter, m_histSys, m_goodMuonForZ->size(),1.0, kWeightUnit);
+        m_histRegistry->Fill(kChInclusive, kRegNone, kVar_NJetAfter, m_histSys, m_goodJet->size(),1.0, kWeightUnit);
         /*
         if (m_goodTau->size() > 0){
           Info("execute()", "=====================================");
@@ -3119,31 +3601,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //------------------------------------
     //if (isBadJet) return EL::StatusCode::SUCCESS;
     if (isBadJet){
-
-      //////////////////////////////////
-      // Delete shallow copy containers
-      //////////////////////////////////
-
-      // The containers created by the shallow copy are owned by you. Remember to delete them
-      delete muons_shallowCopy.first;
-      delete muons_shallowCopy.second;
-
-      delete elec_shallowCopy.first;
-      delete elec_shallowCopy.second;
-
-      delete phot_shallowCopy.first;
-      delete phot_shallowCopy.second;
-
-      delete tau_shallowCopy.first;
-      delete tau_shallowCopy.second;
-
-      delete jet_shallowCopy.first;
-      delete jet_shallowCopy.second;
-
-
       continue; // escape from the systematic loop
     }
-    if (m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("Jet Cleaning");
+    if (m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutJetCleaning);
     if (m_useArrayCutflow) m_eventCutflow[4]+=1;
 
 
@@ -3153,8 +3613,28 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //////////////////////
     // Sort Good Jets //
     //////////////////////
+    // m_goodJet is already in descending pt (m_leadingObjects), the erases keep the order
     m_goodJet->erase(std::remove_if(std::begin(*m_goodJet), std::end(*m_goodJet), [](xAOD::Jet* jet) {return (jet->rapidity() > 4.4);}), std::end(*m_goodJet));
-    std::sort(m_goodJet->begin(), m_goodJet->end(), DescendingPt());
+
+
+
+    //////////////////////////////////////
+    // Snapshot of the selected objects //
+    //////////////////////////////////////
+    // The views are final from here on: the selections below read the stores
+    fillParticleStore(*m_goodMuon, m_muonStore);
+    fillParticleStore(*m_goodMuonForZ, m_muonForZStore);
+    fillParticleStore(*m_baselineMuon, m_baselineMuonStore);
+    fillParticleStore(*m_goodElectron, m_electronStore);
+    fillParticleStore(*m_baselineElectron, m_baselineElectronStore);
+    fillParticleStore(*m_goodTau, m_tauStore);
+    fillParticleStore(*m_goodPhoton, m_photonStore);
+    m_jetStore.Clear();
+    for (const auto& jet : *m_goodJet) {
+      unsigned int flags = 0;
+      if (cachedAccept(m_decisionCache, kDecBTag, m_BJetSelectTool, *jet, jet->pt())) flags |= kFlagBTagged;
+      m_jetStore.Add(jet->pt(), jet->eta(), jet->phi(), jet->m(), jet->rapidity(), 0., jet->index(), flags);
+    }
 
 
 
@@ -3185,211 +3665,72 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // Zmumu MET
     float emulMET_Zmumu = -9e9;
     float emulMET_Zmumu_phi = -9e9;
+    // The same with the cluster soft term (CST)
+    float MET_CST = -9e9;
+    float emulMET_Zee_CST = -9e9;
+    float emulMET_Zmumu_CST = -9e9;
 
 
-    //=============================
-    // Create MissingETContainers 
-    //=============================
-
+    // The MET only changes when an object collection or the soft term is varied;
+    // otherwise reuse the values rebuilt for the nominal
+    const bool rebuildMET = !nominalMET.valid || (sysDeps & (kSysObjects | kSysMETSoftTerm));
 
-    //retrieve the original containers
-    const xAOD::MissingETContainer* m_metCore(0);
-    std::string coreMetKey = "MET_Core_" + jetType;
-    coreMetKey.erase(coreMetKey.length() - 4); //this removes the Jets from the end of the jetType
-    if ( !m_event->retrieve( m_metCore, coreMetKey ).isSuccess() ){ // retrieve arguments: container type, container key
-      Error("execute()", "Unable to retrieve MET core container: " );
-      return EL::StatusCode::FAILURE;
-    }
+    if (rebuildMET) {
 
-    //retrieve the MET association map
-    const xAOD::MissingETAssociationMap* m_metMap(0);
-    std::string metAssocKey = "METAssoc_" + jetType;
-    metAssocKey.erase(metAssocKey.length() - 4 );//this removes the Jets from the end of the jetType
-    if ( !m_event->retrieve( m_metMap, metAssocKey ).isSuccess() ){ // retrieve arguments: container type, container key
-      Error("execute()", "Unable to retrieve MissingETAssociationMap: " );
-      return EL::StatusCode::FAILURE;
-    }
+      //=============================
+      // Create MissingETContainers 
+      //=============================
 
 
-
-    // It is necessary to reset the selected objects before every MET calculation
-    m_met->clear();
-    m_metMap->resetObjSelectionFlags();
-
-
-
-    //===========================
-    // For rebuild the real MET
-    //===========================
-
-    // Electron
-    //-----------------
-    /// Creat New Hard Object Containers
-    // [For MET building] filter the Electron container m_electrons, placing selected electrons into m_MetElectrons
-    ConstDataVector<xAOD::ElectronContainer> m_MetElectrons(SG::VIEW_ELEMENTS); // This is really a DataVector<xAOD::Electron>
-
-    // iterate over our shallow copy
-    for (const auto& electron : *m_goodElectron) { // C++11 shortcut
-      // For MET rebuilding
-      m_MetElectrons.push_back( electron );
-    } // end for loop over shallow copied electrons
-    //const xAOD::ElectronContainer* p_MetElectrons = m_MetElectrons.asDataVector();
-
-    // For real MET
-    m_metMaker->rebuildMET("RefElectron",           //name of metElectrons in metContainer
-        xAOD::Type::Electron,                       //telling the rebuilder that this is electron met
-        m_met,                                      //filling this met container
-        m_MetElectrons.asDataVector(),              //using these metElectrons that accepted our cuts
-        m_metMap);                                  //and this association map
-
-
-    /*
-    // Photon
-    //-----------------
-    /// Creat New Hard Object Containers
-    // [For MET building] filter the Photon container m_photons, placing selected photons into m_MetPhotons
-    ConstDataVector<xAOD::PhotonContainer> m_MetPhotons(SG::VIEW_ELEMENTS); // This is really a DataVector<xAOD::Photon>
-
-    // iterate over our shallow copy
-    for (const auto& photon : *m_goodPhoton) { // C++11 shortcut
-      // For MET rebuilding
-      m_MetPhotons.push_back( photon );
-    } // end for loop over shallow copied photons
-
-    // For real MET
-    m_metMaker->rebuildMET("RefPhoton",           //name of metPhotons in metContainer
-        xAOD::Type::Photon,                       //telling the rebuilder that this is photon met
-        m_met,                                    //filling this met container
-        m_MetPhotons.asDataVector(),              //using these metPhotons that accepted our cuts
-        m_metMap);                                //and this association map
-
-    */
-
-    // TAUS
-    //-----------------
-    /// Creat New Hard Object Containers
-    // [For MET building] filter the TauJet container m_taus, placing selected taus into m_MetTaus
-    ConstDataVector<xAOD::TauJetContainer> m_MetTaus(SG::VIEW_ELEMENTS); // This is really a DataVector<xAOD::TauJet>
-
-    // iterate over our shallow copy
-    for (const auto& taujet : *m_goodTau) { // C++11 shortcut
-      // For MET rebuilding
-      m_MetTaus.push_back( taujet );
-    } // end for loop over shallow copied taus
-
-    // For real MET
-    m_metMaker->rebuildMET("RefTau",           //name of metTaus in metContainer
-        xAOD::Type::Tau,                       //telling the rebuilder that this is tau met
-        m_met,                                 //filling this met container
-        m_MetTaus.asDataVector(),              //using these metTaus that accepted our cuts
-        m_metMap);                             //and this association map
-
-
-    // Muon
-    //-----------------
-    /// Creat New Hard Object Containers
-    // [For MET building] filter the Muon container m_muons, placing selected muons into m_MetMuons
-    ConstDataVector<xAOD::MuonContainer> m_MetMuons(SG::VIEW_ELEMENTS); // This is really a DataVector<xAOD::Muon>
-
-    // iterate over our shallow copy
-    for (const auto& muon : *m_goodMuon) { // C++11 shortcut
-      // For MET rebuilding
-      m_MetMuons.push_back( muon );
-    } // end for loop over shallow copied muons
-    // For real MET
-    m_metMaker->rebuildMET("RefMuon",           //name of metMuons in metContainer
-        xAOD::Type::Muon,                       //telling the rebuilder that this is muon met
-        m_met,                                  //filling this met container
-        m_MetMuons.asDataVector(),              //using these metMuons that accepted our cuts
-        m_metMap);                              //and this association map
-
-
-    // JET
-    //-----------------
-    //Now time to rebuild jetMet and get the soft term
-    //This adds the necessary soft term for both CST and TST
-    //these functions create an xAODMissingET object with the given names inside the container
-    // For real MET
-    m_metMaker->rebuildJetMET("RefJet",          //name of jet met
-        "SoftClus",        //name of soft cluster term met
-        "PVSoftTrk",       //name of soft track term met
-        m_met,             //adding to this new met container
-        jetSC,             //using this jet collection to calculate jet met
-        m_metCore,         //core met container
-        m_metMap,          //with this association map
-        true);             //apply jet jvt cut
-
-
-
-
-    /////////////////////////////
-    // Soft term uncertainties //
-    /////////////////////////////
-    if (!m_isData) {
-      // Get the track soft term (For real MET)
-      xAOD::MissingET* softTrkmet = (*m_met)[softTerm];
-      if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
-        Error("execute()", "METSystematicsTool returns Error CorrectionCode");
+      //retrieve the original containers
+      const xAOD::MissingETContainer* m_metCore(0);
+      std::string coreMetKey = "MET_Core_" + jetType;
+      coreMetKey.erase(coreMetKey.length() - 4); //this removes the Jets from the end of the jetType
+      if ( !m_event->retrieve( m_metCore, coreMetKey ).isSuccess() ){ // retrieve arguments: container type, container key
+        Error("execute()", "Unable to retrieve MET core container: " );
+        return EL::StatusCode::FAILURE;
       }
-    }
-
-
-    ///////////////
-    // MET Build //
-    ///////////////
-    //m_metMaker->rebuildTrackMET("RefJetTrk", softTerm, m_met, jetSC, m_metCore, m_metMap, true);
-
-    //this builds the final track or cluster met sums, using systematic varied container
-    //In the future, you will be able to run both of these on the same container to easily output CST and TST
-
-    // For real MET
-    m_metMaker->buildMETSum("Final", m_met, (*m_met)[softTerm]->source());
-
-
-
-
-    ///////////////////
-    // Fill real MET //
-    ///////////////////
-
-    //MET_ex = ((*m_met)["Final"]->mpx());
-    //MET_ey = ((*m_met)["Final"]->mpy());
-    MET = ((*m_met)["Final"]->met());
-    //SumET = ((*m_met)["Final"]->sumet());
-    MET_phi = ((*m_met)["Final"]->phi());
-
-
-
-
-
-
 
+      //retrieve the MET association map
+      const xAOD::MissingETAssociationMap* m_metMap(0);
+      std::string metAssocKey = "METAssoc_" + jetType;
+      metAssocKey.erase(metAssocKey.length() - 4 );//this removes the Jets from the end of the jetType
+      if ( !m_event->retrieve( m_metMap, metAssocKey ).isSuccess() ){ // retrieve arguments: container type, container key
+        Error("execute()", "Unable to retrieve MissingETAssociationMap: " );
+        return EL::StatusCode::FAILURE;
+      }
 
-    //======================================================================
-    // For rebuild the emulated MET for Wenu (by marking Electron invisible)
-    //======================================================================
 
-    if (m_isWenu) {
 
       // It is necessary to reset the selected objects before every MET calculation
       m_met->clear();
       m_metMap->resetObjSelectionFlags();
 
 
+
+      //===========================
+      // For rebuild the real MET
+      //===========================
+
       // Electron
       //-----------------
       /// Creat New Hard Object Containers
       // [For MET building] filter the Electron container m_electrons, placing selected electrons into m_MetElectrons
-      //
-      // For emulated MET (No electrons)
-      // Make a empty container for invisible electrons
-      ConstDataVector<xAOD::ElectronContainer> m_EmptyElectrons(SG::VIEW_ELEMENTS);
-      m_EmptyElectrons.clear();
+      ConstDataVector<xAOD::ElectronContainer>* m_MetElectrons = m_eventArena->View< ConstDataVector<xAOD::ElectronContainer> >(kArenaMetElectrons); // This is really a DataVector<xAOD::Electron>
+
+      // iterate over our shallow copy
+      for (const auto& electron : *m_goodElectron) { // C++11 shortcut
+        // For MET rebuilding
+        m_MetElectrons->push_back( electron );
+      } // end for loop over shallow copied electrons
+      //const xAOD::ElectronContainer* p_MetElectrons = m_MetElectrons->asDataVector();
+
+      // For real MET
       m_metMaker->rebuildMET("RefElectron",           //name of metElectrons in metContainer
           xAOD::Type::Electron,                       //telling the rebuilder that this is electron met
-          m_met,                           //filling this met container
-          m_EmptyElectrons.asDataVector(),            //using these metElectrons that accepted our cuts
-          m_metMap);                       //and this association map
+          m_met,                                      //filling this met container
+          m_MetElectrons->asDataVector(),              //using these metElectrons that accepted our cuts
+          m_metMap);                                  //and this association map
 
 
       /*
@@ -3397,38 +3738,60 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       //-----------------
       /// Creat New Hard Object Containers
       // [For MET building] filter the Photon container m_photons, placing selected photons into m_MetPhotons
-      // For emulated MET marking electrons invisible
+      ConstDataVector<xAOD::PhotonContainer> m_MetPhotons(SG::VIEW_ELEMENTS); // This is really a DataVector<xAOD::Photon>
+
+      // iterate over our shallow copy
+      for (const auto& photon : *m_goodPhoton) { // C++11 shortcut
+        // For MET rebuilding
+        m_MetPhotons.push_back( photon );
+      } // end for loop over shallow copied photons
+
+      // For real MET
       m_metMaker->rebuildMET("RefPhoton",           //name of metPhotons in metContainer
           xAOD::Type::Photon,                       //telling the rebuilder that this is photon met
-          m_met,                         //filling this met container
+          m_met,                                    //filling this met container
           m_MetPhotons.asDataVector(),              //using these metPhotons that accepted our cuts
-          m_metMap);                     //and this association map
-      */
+          m_metMap);                                //and this association map
 
+      */
 
       // TAUS
       //-----------------
       /// Creat New Hard Object Containers
       // [For MET building] filter the TauJet container m_taus, placing selected taus into m_MetTaus
-      // For emulated MET marking electrons invisible
+      ConstDataVector<xAOD::TauJetContainer>* m_MetTaus = m_eventArena->View< ConstDataVector<xAOD::TauJetContainer> >(kArenaMetTaus); // This is really a DataVector<xAOD::TauJet>
+
+      // iterate over our shallow copy
+      for (const auto& taujet : *m_goodTau) { // C++11 shortcut
+        // For MET rebuilding
+        m_MetTaus->push_back( taujet );
+      } // end for loop over shallow copied taus
+
+      // For real MET
       m_metMaker->rebuildMET("RefTau",           //name of metTaus in metContainer
           xAOD::Type::Tau,                       //telling the rebuilder that this is tau met
-          m_met,                      //filling this met container
-          m_MetTaus.asDataVector(),              //using these metTaus that accepted our cuts
-          m_metMap);                  //and this association map
+          m_met,                                 //filling this met container
+          m_MetTaus->asDataVector(),              //using these metTaus that accepted our cuts
+          m_metMap);                             //and this association map
 
 
       // Muon
       //-----------------
       /// Creat New Hard Object Containers
       // [For MET building] filter the Muon container m_muons, placing selected muons into m_MetMuons
-      //
-      // For emulated MET (No electrons)
+      ConstDataVector<xAOD::MuonContainer>* m_MetMuons = m_eventArena->View< ConstDataVector<xAOD::MuonContainer> >(kArenaMetMuons); // This is really a DataVector<xAOD::Muon>
+
+      // iterate over our shallow copy
+      for (const auto& muon : *m_goodMuon) { // C++11 shortcut
+        // For MET rebuilding
+        m_MetMuons->push_back( muon );
+      } // end for loop over shallow copied muons
+      // For real MET
       m_metMaker->rebuildMET("RefMuon",           //name of metMuons in metContainer
           xAOD::Type::Muon,                       //telling the rebuilder that this is muon met
-          m_met,                       //filling this met container
-          m_MetMuons.asDataVector(),              //using these metMuons that accepted our cuts
-          m_metMap);                   //and this association map
+          m_met,                                  //filling this met container
+          m_MetMuons->asDataVector(),              //using these metMuons that accepted our cuts
+          m_metMap);                              //and this association map
 
 
 
@@ -3437,16 +3800,15 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       //Now time to rebuild jetMet and get the soft term
       //This adds the necessary soft term for both CST and TST
       //these functions create an xAODMissingET object with the given names inside the container
-
-      // For emulated MET marking electrons invisible
+      // For real MET
       m_metMaker->rebuildJetMET("RefJet",          //name of jet met
-          "SoftClus",           //name of soft cluster term met
-          "PVSoftTrk",          //name of soft track term met
-          m_met,     //adding to this new met container
-          jetSC,                //using this jet collection to calculate jet met
-          m_metCore, //core met container
-          m_metMap,  //with this association map
-          true);                //apply jet jvt cut
+          "SoftClus",        //name of soft cluster term met
+          "PVSoftTrk",       //name of soft track term met
+          m_met,             //adding to this new met container
+          jetSC,             //using this jet collection to calculate jet met
+          m_metCore,         //core met container
+          m_metMap,          //with this association map
+          true);             //apply jet jvt cut
 
 
 
@@ -3455,356 +3817,219 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       // Soft term uncertainties //
       /////////////////////////////
       if (!m_isData) {
-        // Get the track soft term for Wenu (For emulated MET marking electrons invisible)
+        // Get the track soft term (For real MET)
+        // The tool only has the TST configuration: the cluster soft term (CST) is not corrected
         xAOD::MissingET* softTrkmet = (*m_met)[softTerm];
+        // The envelope needs the soft term shifts of the other passes of this event
+        if (m_doSysEnvelope && !sysEnvelope.valid) {
+          if (!SoftTermEnvelopeShift(softTrkmet, sysList, sysEnvelope.softTermShift)) return EL::StatusCode::FAILURE;
+        }
         if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
           Error("execute()", "METSystematicsTool returns Error CorrectionCode");
         }
       }
 
 
-
       ///////////////
       // MET Build //
       ///////////////
-      // For emulated MET for Wenu marking electrons invisible
-      m_metMaker->buildMETSum("Final", m_met, (*m_met)[softTerm]->source());
-
+      //m_metMaker->rebuildTrackMET("RefJetTrk", softTerm, m_met, jetSC, m_metCore, m_metMap, true);
 
+      //this builds the final track or cluster met sums, using systematic varied container
+      //Both soft terms come from the same rebuildJetMET, so CST and TST are summed from the same container
 
-      /////////////////////////////////////////////////////////////////
-      // Fill emulated MET for Wenu (by marking electrons invisible) //
-      /////////////////////////////////////////////////////////////////
-      //emulMET_Wenu_ex = ((*m_met)["Final"]->mpx());
-      //emulMET_Wenu_ey = ((*m_met)["Final"]->mpy());
-      emulMET_Wenu = ((*m_met)["Final"]->met());
-      //emulSumET_Wenu = ((*m_met)["Final"]->sumet());
-      emulMET_Wenu_phi = ((*m_met)["Final"]->phi());
-
-
-
-    } // m_isWenu
+      // For real MET
+      m_metMaker->buildMETSum("Final", m_met, (*m_met)[softTerm]->source());
+      // With the cluster soft term (CST)
+      m_metMaker->buildMETSum("FinalClus", m_met, (*m_met)["SoftClus"]->source());
 
 
 
 
+      ///////////////////
+      // Fill real MET //
+      ///////////////////
 
+      //MET_ex = ((*m_met)["Final"]->mpx());
+      //MET_ey = ((*m_met)["Final"]->mpy());
+      MET = ((*m_met)["Final"]->met());
+      //SumET = ((*m_met)["Final"]->sumet());
+      MET_phi = ((*m_met)["Final"]->phi());
+      MET_CST = ((*m_met)["FinalClus"]->met());
 
 
 
-    //=====================================================================
-    // For rebuild the emulated MET for Zee (by marking Electron invisible)
-    //=====================================================================
 
-    if (m_isZee) {
+      //=====================================================================
+      // Emulated MET (Wenu, Zee, Wmunu, Zmumu)
+      //=====================================================================
+      // A hypothesis is a sum of the real MET terms when its rebuild claims
+      // the same objects in the same order, so that the jet and soft terms are
+      // the same: Wmunu always, Wenu without electrons, Zee without muons and
+      // taus. Otherwise (and for Zmumu, which adds ghost muons to the jets) the
+      // MET is rebuilt. The soft term variations depend on the hard term of
+      // each hypothesis, so the soft term systematics always rebuild.
+      // Zee and Zmumu do not add photon, tau or other lepton terms as we veto
+      // on additional leptons and photons might be an issue for muon FSR.
 
-      // It is necessary to reset the selected objects before every MET calculation
-      m_met->clear();
-      m_metMap->resetObjSelectionFlags();
+      const bool useTerms = !(sysDeps & kSysMETSoftTerm);
+      const bool wenuFromTerms = useTerms && m_goodElectron->empty();
+      const bool zeeFromTerms = useTerms && m_goodMuon->empty() && m_goodTau->empty();
+      const bool wmunuFromTerms = useTerms;
 
+      const xAOD::MissingET* metElectron = (*m_met)["RefElectron"];
+      const xAOD::MissingET* metTau = (*m_met)["RefTau"];
+      const double hadronic_mpx = (*m_met)["RefJet"]->mpx() + (*m_met)[softTerm]->mpx();
+      const double hadronic_mpy = (*m_met)["RefJet"]->mpy() + (*m_met)[softTerm]->mpy();
+      const double hadronicCST_mpx = (*m_met)["RefJet"]->mpx() + (*m_met)["SoftClus"]->mpx();
+      const double hadronicCST_mpy = (*m_met)["RefJet"]->mpy() + (*m_met)["SoftClus"]->mpy();
+      float emulMET_CST_phi;
 
-      // Electron
-      //-----------------
-      /// Creat New Hard Object Containers
-      // [For MET building] filter the Electron container m_electrons, placing selected electrons into m_MetElectrons
-      //
-      // For emulated MET (No electrons)
-      // Make a empty container for invisible electrons
-      /*
-         ConstDataVector<xAOD::ElectronContainer> m_EmptyElectrons(SG::VIEW_ELEMENTS);
-         m_EmptyElectrons.clear();
-         m_metMaker->rebuildMET("RefElectron",           //name of metElectrons in metContainer
-         xAOD::Type::Electron,                       //telling the rebuilder that this is electron met
-         m_met,                           //filling this met container
-         m_EmptyElectrons.asDataVector(),            //using these metElectrons that accepted our cuts
-         m_metMap);                       //and this association map
-         */
-      // Make a container for invisible electrons
-      ConstDataVector<xAOD::ElectronContainer> m_invisibleElectrons(SG::VIEW_ELEMENTS);
-      for (const auto& electron : *m_goodElectron) { // C++11 shortcut
-        m_invisibleElectrons.push_back( electron );
+      // Wenu (no electrons): the real MET
+      if (m_isWenu && wenuFromTerms) {
+        emulMET_Wenu = MET;
+        emulMET_Wenu_phi = MET_phi;
       }
-      // Mark electrons invisible (No electrons)
-      m_metMaker->markInvisible(m_invisibleElectrons.asDataVector(), m_metMap);
-
-      // Not adding Photon, Tau, Muon objects as we veto on additional leptons and photons might be an issue for muon FSR
-
-
-      // JET
-      //-----------------
-      //Now time to rebuild jetMet and get the soft term
-      //This adds the necessary soft term for both CST and TST
-      //these functions create an xAODMissingET object with the given names inside the container
-
-      // For emulated MET marking electrons invisible
-      m_metMaker->rebuildJetMET("RefJet",          //name of jet met
-          "SoftClus",           //name of soft cluster term met
-          "PVSoftTrk",          //name of soft track term met
-          m_met,     //adding to this new met container
-          jetSC,                //using this jet collection to calculate jet met
-          m_metCore, //core met container
-          m_metMap,  //with this association map
-          true);                //apply jet jvt cut
-
-
-
-      /////////////////////////////
-      // Soft term uncertainties //
-      /////////////////////////////
-      if (!m_isData) {
-        // Get the track soft term for Zee (For emulated MET marking electrons invisible)
-        xAOD::MissingET* softTrkmet = (*m_met)[softTerm];
-        if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
-          Error("execute()", "METSystematicsTool returns Error CorrectionCode");
-        }
+      // Zee (electrons invisible): jet and soft terms
+      if (m_isZee && zeeFromTerms) {
+        setMET(hadronic_mpx, hadronic_mpy, emulMET_Zee, emulMET_Zee_phi);
+        setMET(hadronicCST_mpx, hadronicCST_mpy, emulMET_Zee_CST, emulMET_CST_phi);
+      }
+      // Wmunu (muons invisible): all terms but the muon one
+      if (m_isWmunu && wmunuFromTerms) {
+        setMET(hadronic_mpx + metElectron->mpx() + metTau->mpx(), hadronic_mpy + metElectron->mpy() + metTau->mpy(),
+            emulMET_Wmunu, emulMET_Wmunu_phi);
       }
 
-
-      ///////////////
-      // MET Build //
-      ///////////////
-      // For emulated MET for Zee marking electrons invisible
-      m_metMaker->buildMETSum("Final", m_met, (*m_met)[softTerm]->source());
-
-
-      ////////////////////////////////////////////////////////////////
-      // Fill emulated MET for Zee (by marking electrons invisible) //
-      ////////////////////////////////////////////////////////////////
-      //emulMET_Zee_ex = ((*m_met)["Final"]->mpx());
-      //emulMET_Zee_ey = ((*m_met)["Final"]->mpy());
-      emulMET_Zee = ((*m_met)["Final"]->met());
-      //emulSumET_Zee = ((*m_met)["Final"]->sumet());
-      emulMET_Zee_phi = ((*m_met)["Final"]->phi());
-
-
-    } // m_isZee
-
-
-
-
-
-    //===================================================================
-    // For rebuild the emulated MET for Wmunu (by marking Muon invisible)
-    //===================================================================
-
-    if (m_isWmunu) {
-
-      // It is necessary to reset the selected objects before every MET calculation
-      m_met->clear();
-      m_metMap->resetObjSelectionFlags();
-
-      // Electron
-      //-----------------
-      /// Creat New Hard Object Containers
-      // [For MET building] filter the Electron container m_electrons, placing selected electrons into m_MetElectrons
-      // For emulated MET (No muons)
-      m_metMaker->rebuildMET("RefElectron",           //name of metElectrons in metContainer
-          xAOD::Type::Electron,                       //telling the rebuilder that this is electron met
-          m_met,                             //filling this met container
-          m_MetElectrons.asDataVector(),              //using these metElectrons that accepted our cuts
-          m_metMap);                         //and this association map
-
-
-      /*
-      // Photon
-      //-----------------
-      /// Creat New Hard Object Containers
-      // [For MET building] filter the Photon container m_photons, placing selected photons into m_MetPhotons
-      // For emulated MET marking muons invisible
-      m_metMaker->rebuildMET("RefPhoton",           //name of metPhotons in metContainer
-          xAOD::Type::Photon,                       //telling the rebuilder that this is photon met
-          m_met,                           //filling this met container
-          m_MetPhotons.asDataVector(),              //using these metPhotons that accepted our cuts
-          m_metMap);                       //and this association map
-      */
-
-
-      // TAUS
-      //-----------------
-      //
-      /// Creat New Hard Object Containers
-      // [For MET building] filter the TauJet container m_taus, placing selected taus into m_MetTaus
-      // For emulated MET marking muons invisible
-      m_metMaker->rebuildMET("RefTau",           //name of metTaus in metContainer
-          xAOD::Type::Tau,                       //telling the rebuilder that this is tau met
-          m_met,                        //filling this met container
-          m_MetTaus.asDataVector(),              //using these metTaus that accepted our cuts
-          m_metMap);                    //and this association map
-
-
-
-      /*
-      // Muon
-      //-----------------
-      /// Creat New Hard Object Containers
-      // [For MET building] filter the Muon container m_muons, placing selected muons into m_MetMuons
-      //
-      // For emulated MET (No muons)
-      // Make a empty container for invisible electrons
+      // Rebuilds of the hypotheses (the real MET terms are not used below)
+      ConstDataVector<xAOD::ElectronContainer> m_EmptyElectrons(SG::VIEW_ELEMENTS);
       ConstDataVector<xAOD::MuonContainer> m_EmptyMuons(SG::VIEW_ELEMENTS);
-      m_EmptyMuons.clear();
-      m_metMaker->rebuildMET("RefMuon",           //name of metMuons in metContainer
-          xAOD::Type::Muon,                       //telling the rebuilder that this is muon met
-          m_met,                         //filling this met container
-          m_EmptyMuons.asDataVector(),            //using these metMuons that accepted our cuts
-          m_metMap);                     //and this association map
-      */
-      // Make a container for invisible muons
-      ConstDataVector<xAOD::MuonContainer> m_invisibleMuons(SG::VIEW_ELEMENTS);
-      for (const auto& muon : *m_goodMuon) { // C++11 shortcut
-        m_invisibleMuons.push_back( muon );
+      float rebuiltMET, rebuiltMET_phi, rebuiltMET_CST;
+
+      // Wenu: empty electron term, electrons not marked invisible
+      if (m_isWenu && (!wenuFromTerms || m_validateEmulatedMET)) {
+        RebuildEmulatedMET(m_met, m_metCore, m_metMap, softTerm, m_EmptyElectrons.asDataVector(), m_MetTaus->asDataVector(),
+            m_MetMuons->asDataVector(), 0, jetSC, rebuiltMET, rebuiltMET_phi, rebuiltMET_CST);
+        if (wenuFromTerms) CompareEmulatedMET("Wenu", emulMET_Wenu, emulMET_Wenu_phi, rebuiltMET, rebuiltMET_phi);
+        else {
+          emulMET_Wenu = rebuiltMET;
+          emulMET_Wenu_phi = rebuiltMET_phi;
+        }
       }
-      // Mark muons invisible
-      m_metMaker->markInvisible(m_invisibleMuons.asDataVector(), m_metMap);
-
-
-      // JET
-      //-----------------
-      //Now time to rebuild jetMet and get the soft term
-      //This adds the necessary soft term for both CST and TST
-      //these functions create an xAODMissingET object with the given names inside the container
 
-      // For emulated MET marking muons invisible
-      m_metMaker->rebuildJetMET("RefJet",          //name of jet met
-          "SoftClus",           //name of soft cluster term met
-          "PVSoftTrk",          //name of soft track term met
-          m_met,       //adding to this new met container
-          jetSC,                //using this jet collection to calculate jet met
-          m_metCore,   //core met container
-          m_metMap,    //with this association map
-          true);                //apply jet jvt cut
-
-
-
-
-      /////////////////////////////
-      // Soft term uncertainties //
-      /////////////////////////////
-      if (!m_isData) {
-        // Get the track soft term for Wmunu (For emulated MET marking muons invisible)
-        xAOD::MissingET* softTrkmet = (*m_met)[softTerm];
-        if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
-          Error("execute()", "METSystematicsTool returns Error CorrectionCode");
+      // Zee: electrons invisible
+      if (m_isZee && (!zeeFromTerms || m_validateEmulatedMET)) {
+        RebuildEmulatedMET(m_met, m_metCore, m_metMap, softTerm, 0, 0, 0, m_MetElectrons->asDataVector(),
+            jetSC, rebuiltMET, rebuiltMET_phi, rebuiltMET_CST);
+        if (zeeFromTerms) {
+          CompareEmulatedMET("Zee", emulMET_Zee, emulMET_Zee_phi, rebuiltMET, rebuiltMET_phi);
+          CompareEmulatedMET("Zee CST", emulMET_Zee_CST, 0., rebuiltMET_CST, 0.);
+        }
+        else {
+          emulMET_Zee = rebuiltMET;
+          emulMET_Zee_phi = rebuiltMET_phi;
+          emulMET_Zee_CST = rebuiltMET_CST;
         }
       }
 
-
-
-      ///////////////
-      // MET Build //
-      ///////////////
-      // For emulated MET for Wmunu marking muons invisible
-      m_metMaker->buildMETSum("Final", m_met, (*m_met)[softTerm]->source());
-
-
-      //////////////////////////////////////////////////////////////
-      // Fill emulated MET for Wmunu (by marking muons invisible) //
-      //////////////////////////////////////////////////////////////
-      //emulMET_Wmunu_ex = ((*m_met)["Final"]->mpx());
-      //emulMET_Wmunu_ey = ((*m_met)["Final"]->mpy());
-      emulMET_Wmunu = ((*m_met)["Final"]->met());
-      //emulSumET_Wmunu = ((*m_met)["Final"]->sumet());
-      emulMET_Wmunu_phi = ((*m_met)["Final"]->phi());
-
-
-    } // m_isWmunu
-
-
-
-
-
-
-
-
-    //===================================================================
-    // For rebuild the emulated MET for Zmumu (by marking Muon invisible)
-    //===================================================================
-
-    if (m_isZmumu) {
-
-      // It is necessary to reset the selected objects before every MET calculation
-      m_met->clear();
-      m_metMap->resetObjSelectionFlags();
-
-
-      // Not adding Electron, Photon, Tau objects as we veto on additional leptons and photons might be an issue for muon FSR
-
-      // Muon
-      //-----------------
-      /// Creat New Hard Object Containers
-      // [For MET building] filter the Muon container m_muons, placing selected muons into m_MetMuons
-      //
-      // For emulated MET (No muons)
-      // Make a empty container for invisible electrons
-      ConstDataVector<xAOD::MuonContainer> m_EmptyMuons(SG::VIEW_ELEMENTS);
-      m_EmptyMuons.clear();
-      m_metMaker->rebuildMET("RefMuon",           //name of metMuons in metContainer
-          xAOD::Type::Muon,                       //telling the rebuilder that this is muon met
-          m_met,                         //filling this met container
-          m_EmptyMuons.asDataVector(),            //using these metMuons that accepted our cuts
-          m_metMap);                     //and this association map
-      // Make a container for invisible muons
-      ConstDataVector<xAOD::MuonContainer> m_invisibleMuonsForZ(SG::VIEW_ELEMENTS);
-      for (const auto& muon : *m_goodMuonForZ) { // C++11 shortcut
-        m_invisibleMuonsForZ.push_back( muon );
+      // Wmunu: muons invisible
+      if (m_isWmunu && (!wmunuFromTerms || m_validateEmulatedMET)) {
+        RebuildEmulatedMET(m_met, m_metCore, m_metMap, softTerm, m_MetElectrons->asDataVector(), m_MetTaus->asDataVector(),
+            0, m_MetMuons->asDataVector(), jetSC, rebuiltMET, rebuiltMET_phi, rebuiltMET_CST);
+        if (wmunuFromTerms) CompareEmulatedMET("Wmunu", emulMET_Wmunu, emulMET_Wmunu_phi, rebuiltMET, rebuiltMET_phi);
+        else {
+          emulMET_Wmunu = rebuiltMET;
+          emulMET_Wmunu_phi = rebuiltMET_phi;
+        }
       }
-      // Mark muons invisible
-      m_metMaker->markInvisible(m_invisibleMuonsForZ.asDataVector(), m_metMap);
-
-      met::addGhostMuonsToJets(*m_muons, *jetSC);
-
 
-      // JET
-      //-----------------
-      //Now time to rebuild jetMet and get the soft term
-      //This adds the necessary soft term for both CST and TST
-      //these functions create an xAODMissingET object with the given names inside the container
-
-      // For emulated MET marking muons invisible
-      m_metMaker->rebuildJetMET("RefJet",          //name of jet met
-          "SoftClus",           //name of soft cluster term met
-          "PVSoftTrk",          //name of soft track term met
-          m_met,       //adding to this new met container
-          jetSC,                //using this jet collection to calculate jet met
-          m_metCore,   //core met container
-          m_metMap,    //with this association map
-          true);                //apply jet jvt cut
-
-
-
-
-      /////////////////////////////
-      // Soft term uncertainties //
-      /////////////////////////////
-      if (!m_isData) {
-        // Get the track soft term for Zmumu (For emulated MET marking muons invisible)
-        xAOD::MissingET* softTrkmet = (*m_met)[softTerm];
-        if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
-          Error("execute()", "METSystematicsTool returns Error CorrectionCode");
+      // Zmumu: empty muon term, the muons for Z invisible and ghost muons in the jets
+      if (m_isZmumu) {
+        ConstDataVector<xAOD::MuonContainer>* m_invisibleMuonsForZ = m_eventArena->View< ConstDataVector<xAOD::MuonContainer> >(kArenaInvisibleMuonsForZ);
+        for (const auto& muon : *m_goodMuonForZ) { // C++11 shortcut
+          m_invisibleMuonsForZ->push_back( muon );
         }
+        // The ghost muons are only for this rebuild: the jet copy may be reused
+        // by later passes, so its input association is put back afterwards
+        std::vector< std::vector<const xAOD::IParticle*> > inputGhostMuons(jetSC->size());
+        for (unsigned int i = 0; i < jetSC->size(); i++)
+          jetSC->at(i)->getAssociatedObjects<xAOD::IParticle>("GhostMuon", inputGhostMuons[i]);
+        met::addGhostMuonsToJets(*m_muons, *jetSC);
+
+        RebuildEmulatedMET(m_met, m_metCore, m_metMap, softTerm, 0, 0, m_EmptyMuons.asDataVector(),
+            m_invisibleMuonsForZ->asDataVector(), jetSC, emulMET_Zmumu, emulMET_Zmumu_phi, emulMET_Zmumu_CST);
+
+        for (unsigned int i = 0; i < jetSC->size(); i++)
+          jetSC->at(i)->setAssociatedObjects("GhostMuon", inputGhostMuons[i]);
       }
 
 
+      if (!(sysDeps & (kSysObjects | kSysMETSoftTerm))) {
+        nominalMET.valid = true;
+        nominalMET.MET = MET;
+        nominalMET.MET_phi = MET_phi;
+        nominalMET.emulMET_Wenu = emulMET_Wenu;
+        nominalMET.emulMET_Wenu_phi = emulMET_Wenu_phi;
+        nominalMET.emulMET_Zee = emulMET_Zee;
+        nominalMET.emulMET_Zee_phi = emulMET_Zee_phi;
+        nominalMET.emulMET_Wmunu = emulMET_Wmunu;
+        nominalMET.emulMET_Wmunu_phi = emulMET_Wmunu_phi;
+        nominalMET.emulMET_Zmumu = emulMET_Zmumu;
+        nominalMET.emulMET_Zmumu_phi = emulMET_Zmumu_phi;
+        nominalMET.MET_CST = MET_CST;
+        nominalMET.emulMET_Zee_CST = emulMET_Zee_CST;
+        nominalMET.emulMET_Zmumu_CST = emulMET_Zmumu_CST;
+      }
 
-      ///////////////
-      // MET Build //
-      ///////////////
-      // For emulated MET for Zmumu marking muons invisible
-      m_metMaker->buildMETSum("Final", m_met, (*m_met)[softTerm]->source());
-
-
-
-      //////////////////////////////////////////////////////////////
-      // Fill emulated MET for Zmumu (by marking muons invisible) //
-      //////////////////////////////////////////////////////////////
-      //emulMET_Zmumu_ex = ((*m_met)["Final"]->mpx());
-      //emulMET_Zmumu_ey = ((*m_met)["Final"]->mpy());
-      emulMET_Zmumu = ((*m_met)["Final"]->met());
-      //emulSumET_Zmumu = ((*m_met)["Final"]->sumet());
-      emulMET_Zmumu_phi = ((*m_met)["Final"]->phi());
-
+    } // rebuildMET
+    else {
+      MET = nominalMET.MET;
+      MET_phi = nominalMET.MET_phi;
+      emulMET_Wenu = nominalMET.emulMET_Wenu;
+      emulMET_Wenu_phi = nominalMET.emulMET_Wenu_phi;
+      emulMET_Zee = nominalMET.emulMET_Zee;
+      emulMET_Zee_phi = nominalMET.emulMET_Zee_phi;
+      emulMET_Wmunu = nominalMET.emulMET_Wmunu;
+      emulMET_Wmunu_phi = nominalMET.emulMET_Wmunu_phi;
+      emulMET_Zmumu = nominalMET.emulMET_Zmumu;
+      emulMET_Zmumu_phi = nominalMET.emulMET_Zmumu_phi;
+      MET_CST = nominalMET.MET_CST;
+      emulMET_Zee_CST = nominalMET.emulMET_Zee_CST;
+      emulMET_Zmumu_CST = nominalMET.emulMET_Zmumu_CST;
+    }
+
+
+    //-----------------------
+    // Systematics envelope
+    //-----------------------
+    // Every region needs MET (or emulated MET) above m_metCut and a leading jet.
+    // Bound both over all variations from this pass: the recoil can at most
+    // gain the (shifted) momenta of the leptons, photons and taus, which can be
+    // made invisible or leave the MET, the jet shifts (the full momentum of
+    // the jets soft enough to cross the RefJet cuts) and the measured soft
+    // term shift. The object shifts are doubled when this first pass is
+    // itself a variation.
+    if (m_doSysEnvelope && !sysEnvelope.valid) {
+      const float shiftScale = activeSys.isNominal ? 1. : 2.;
+      const float jetShift = shiftScale * m_envelopeJetShift;
+      const float lepShift = shiftScale * m_envelopeLeptonShift;
+      float sumJetPt = 0, maxJetPt = 0, sumMigratingJetPt = 0, sumLepPt = 0;
+      for (const auto& jet : *jetSC) {
+        if ((1. - jetShift) * jet->pt() < m_envelopeJetMigrationPt) sumMigratingJetPt += jet->pt();
+        else sumJetPt += jet->pt();
+        if (fabs(jet->eta()) < m_jetEtaCut && jet->pt() > maxJetPt) maxJetPt = jet->pt();
+      }
+      for (const auto& muon : *muonSC) sumLepPt += muon->pt();
+      for (const auto& electron : *elecSC) sumLepPt += electron->pt();
+      for (const auto& photon : *photSC) sumLepPt += photon->pt();
+      for (const auto& tau : *tauSC) sumLepPt += tau->pt();
 
-    } // m_isZmumu
+      const float maxRecoil = MET + (1. + lepShift) * sumLepPt + jetShift * sumJetPt +
+        (1. + jetShift) * sumMigratingJetPt + sysEnvelope.softTermShift;
+      const float minLeadJetPt = std::min(m_monoJetPtCut, std::min(m_diJet1PtCut, m_sm1JetPtCut));
+      sysEnvelope.valid = true;
+      sysEnvelope.reachable = maxRecoil > m_metCut && (1. + jetShift) * maxJetPt > minLeadJetPt;
+    }
 
 
 
@@ -3828,8 +4053,6 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     float dPhiMonojetMet_Zee = 0;
     float dPhiMonojetMet_Wenu = 0;
     // Dijet
-    TLorentzVector jet1;
-    TLorentzVector jet2;
     float jet1_pt = 0;
     float jet2_pt = 0;
     float jet3_pt = 0;
@@ -3870,6 +4093,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     float dPhiJet3Met_Wenu = 0;
 
     float mjj = 0;
+    float dPhijj = 0;
+    float dRjj = 0;
     bool pass_monoJet = false; // Select monoJet
     bool pass_diJet = false; // Select DiJet
     bool pass_CJV = true; // Central Jet Veto (CJV)
@@ -3886,48 +4111,54 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     float dPhiMinjetmet_Wenu = 10.; // initialize with 10. to obtain minimum value of deltaPhi(Jet_i,MET)
 
 
+    //-----------------------------------------
+    // Jet topology (single pass over the jets)
+    //-----------------------------------------
+    float metPhiHypotheses[kNumMetHypotheses];
+    metPhiHypotheses[kMetZnunu] = MET_phi;
+    metPhiHypotheses[kMetZmumu] = emulMET_Zmumu_phi;
+    metPhiHypotheses[kMetWmunu] = emulMET_Wmunu_phi;
+    metPhiHypotheses[kMetZee] = emulMET_Zee_phi;
+    metPhiHypotheses[kMetWenu] = emulMET_Wenu_phi;
+    unsigned int activeMetHypotheses = 0;
+    if (m_isZnunu) activeMetHypotheses |= 1 << kMetZnunu;
+    if (m_isZmumu) activeMetHypotheses |= 1 << kMetZmumu;
+    if (m_isWmunu) activeMetHypotheses |= 1 << kMetWmunu;
+    if (m_isZee) activeMetHypotheses |= 1 << kMetZee;
+    if (m_isWenu) activeMetHypotheses |= 1 << kMetWenu;
+
+    JetTopologyResult jetTopo;
+    m_jetTopology->Compute(m_jetStore, metPhiHypotheses, activeMetHypotheses, jetTopo);
+
+
+
     ///////////////////////
     // Monojet Selection //
     ///////////////////////
-    if (m_goodJet->size() > 0) {
+    if (jetTopo.nJets > 0) {
 
-      monojet_pt = m_goodJet->at(0)->pt();
-      monojet_phi = m_goodJet->at(0)->phi();
-      monojet_eta = m_goodJet->at(0)->eta();
-      monojet_rapidity = m_goodJet->at(0)->rapidity();
+      monojet_pt = m_jetStore.Pt(0);
+      monojet_phi = m_jetStore.Phi(0);
+      monojet_eta = m_jetStore.Eta(0);
+      monojet_rapidity = m_jetStore.Rapidity(0);
 
 
       // Define Monojet
       if ( monojet_pt > m_monoJetPtCut ){
         if ( fabs(monojet_eta) < m_monoJetEtaCut){
-          if ( m_jetCleaningTight->accept( *m_goodJet->at(0) ) ){ //Tight Leading Jet 
+          if ( cachedAccept(m_decisionCache, kDecJetCleanTight, m_jetCleaningTight, *m_goodJet->at(0), m_goodJet->at(0)->pt()) ){ //Tight Leading Jet 
             pass_monoJet = true;
             //Info("execute()", "  Leading jet pt = %.2f GeV", monojet_pt * 0.001);
           }
         }
       }
 
-      // deltaPhi(monojet,MET) decision
-      // For Znunu
-      if (m_isZnunu){
-        dPhiMonojetMet = deltaPhi(monojet_phi, MET_phi);
-      }
-      // For Zmumu
-      if (m_isZmumu){
-        dPhiMonojetMet_Zmumu = deltaPhi(monojet_phi, emulMET_Zmumu_phi);
-      }
-      // For Wmunu
-      if (m_isWmunu){
-        dPhiMonojetMet_Wmunu = deltaPhi(monojet_phi, emulMET_Wmunu_phi);
-      }
-      // For Zee
-      if (m_isZee){
-        dPhiMonojetMet_Zee = deltaPhi(monojet_phi, emulMET_Zee_phi);
-      }
-      // For Wenu
-      if (m_isWenu){
-        dPhiMonojetMet_Wenu = deltaPhi(monojet_phi, emulMET_Wenu_phi);
-      }
+      // deltaPhi(monojet,MET) decision (0 for the channels not enabled)
+      dPhiMonojetMet = jetTopo.dPhiJetMet[kMetZnunu][0];
+      dPhiMonojetMet_Zmumu = jetTopo.dPhiJetMet[kMetZmumu][0];
+      dPhiMonojetMet_Wmunu = jetTopo.dPhiJetMet[kMetWmunu][0];
+      dPhiMonojetMet_Zee = jetTopo.dPhiJetMet[kMetZee][0];
+      dPhiMonojetMet_Wenu = jetTopo.dPhiJetMet[kMetWenu][0];
 
     } // MonoJet selection 
 
@@ -3936,20 +4167,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     /////////////////////
     // DiJet Selection //
     /////////////////////
-    if (m_goodJet->size() > 1) {
-
-      jet1 = m_goodJet->at(0)->p4();
-      jet2 = m_goodJet->at(1)->p4();
-      jet1_pt = m_goodJet->at(0)->pt();
-      jet2_pt = m_goodJet->at(1)->pt();
-      jet1_phi = m_goodJet->at(0)->phi();
-      jet2_phi = m_goodJet->at(1)->phi();
-      jet1_eta = m_goodJet->at(0)->eta();
-      jet2_eta = m_goodJet->at(1)->eta();
-      jet1_rapidity = m_goodJet->at(0)->rapidity();
-      jet2_rapidity = m_goodJet->at(1)->rapidity();
-      auto dijet = jet1 + jet2;
-      mjj = dijet.M();
+    if (jetTopo.nJets > 1) {
+
+      jet1_pt = m_jetStore.Pt(0);
+      jet2_pt = m_jetStore.Pt(1);
+      jet1_phi = m_jetStore.Phi(0);
+      jet2_phi = m_jetStore.Phi(1);
+      jet1_eta = m_jetStore.Eta(0);
+      jet2_eta = m_jetStore.Eta(1);
+      jet1_rapidity = m_jetStore.Rapidity(0);
+      jet2_rapidity = m_jetStore.Rapidity(1);
+      mjj = jetTopo.mjj;
+      dPhijj = jetTopo.dPhijj;
+      dRjj = jetTopo.dRjj;
 
       //Info("execute()", "  jet1 = %.2f GeV, jet2 = %.2f GeV", jet1_pt * 0.001, jet2_pt * 0.001);
       //Info("execute()", "  mjj = %.2f GeV", mjj * 0.001);
@@ -3957,158 +4187,67 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       // Define Dijet
       if ( jet1_pt > m_diJet1PtCut && jet2_pt > m_diJet2PtCut ){
         if ( fabs(jet1_rapidity) < m_diJetRapCut && fabs(jet2_rapidity) < m_diJetRapCut ){
-          if ( m_jetCleaningTight->accept( *m_goodJet->at(0) ) ){ //Tight Leading Jet 
+          if ( cachedAccept(m_decisionCache, kDecJetCleanTight, m_jetCleaningTight, *m_goodJet->at(0), m_goodJet->at(0)->pt()) ){ //Tight Leading Jet 
             pass_diJet = true;
           }
         }
       }
 
-      // deltaPhi(Jet1,MET) or deltaPhi(Jet2,MET) decision
-      // For Znunu
-      if (m_isZnunu){
-        dPhiJet1Met = deltaPhi(jet1_phi, MET_phi);
-        dPhiJet2Met = deltaPhi(jet2_phi, MET_phi);
-      }
-      // For Zmumu
-      if (m_isZmumu){
-        dPhiJet1Met_Zmumu = deltaPhi(jet1_phi, emulMET_Zmumu_phi);
-        dPhiJet2Met_Zmumu = deltaPhi(jet2_phi, emulMET_Zmumu_phi);
-      }
-      // For Wmunu
-      if (m_isWmunu){
-        dPhiJet1Met_Wmunu = deltaPhi(jet1_phi, emulMET_Wmunu_phi);
-        dPhiJet2Met_Wmunu = deltaPhi(jet2_phi, emulMET_Wmunu_phi);
-      }
-      // For Zee
-      if (m_isZee){
-        dPhiJet1Met_Zee = deltaPhi(jet1_phi, emulMET_Zee_phi);
-        dPhiJet2Met_Zee = deltaPhi(jet2_phi, emulMET_Zee_phi);
-      }
-      // For Wenu
-      if (m_isWenu){
-        dPhiJet1Met_Wenu = deltaPhi(jet1_phi, emulMET_Wenu_phi);
-        dPhiJet2Met_Wenu = deltaPhi(jet2_phi, emulMET_Wenu_phi);
-      }
+      // deltaPhi(Jet1,MET) or deltaPhi(Jet2,MET) decision (0 for the channels not enabled)
+      dPhiJet1Met = jetTopo.dPhiJetMet[kMetZnunu][0];
+      dPhiJet2Met = jetTopo.dPhiJetMet[kMetZnunu][1];
+      dPhiJet1Met_Zmumu = jetTopo.dPhiJetMet[kMetZmumu][0];
+      dPhiJet2Met_Zmumu = jetTopo.dPhiJetMet[kMetZmumu][1];
+      dPhiJet1Met_Wmunu = jetTopo.dPhiJetMet[kMetWmunu][0];
+      dPhiJet2Met_Wmunu = jetTopo.dPhiJetMet[kMetWmunu][1];
+      dPhiJet1Met_Zee = jetTopo.dPhiJetMet[kMetZee][0];
+      dPhiJet2Met_Zee = jetTopo.dPhiJetMet[kMetZee][1];
+      dPhiJet1Met_Wenu = jetTopo.dPhiJetMet[kMetWenu][0];
+      dPhiJet2Met_Wenu = jetTopo.dPhiJetMet[kMetWenu][1];
 
     } // DiJet selection 
 
 
 
     // For jet3
-    if (m_goodJet->size() > 2) {
-      jet3_pt = m_goodJet->at(2)->pt();
-      jet3_phi = m_goodJet->at(2)->phi();
-      jet3_eta = m_goodJet->at(2)->eta();
-      jet3_rapidity = m_goodJet->at(2)->rapidity();
-      // deltaPhi(Jet3,MET)
+    if (jetTopo.nJets > 2) {
+      jet3_pt = m_jetStore.Pt(2);
+      jet3_phi = m_jetStore.Phi(2);
+      jet3_eta = m_jetStore.Eta(2);
+      jet3_rapidity = m_jetStore.Rapidity(2);
+      // deltaPhi(Jet3,MET), for every MET hypothesis whether its channel is enabled or not
       dPhiJet3Met = deltaPhi(jet3_phi, MET_phi);
-      dPhiJet3Met_Zmumu = deltaPhi(jet3_phi, emulMET_Zmumu_phi);
-      dPhiJet3Met_Wmunu = deltaPhi(jet3_phi, emulMET_Wmunu_phi);
-      dPhiJet3Met_Zee = deltaPhi(jet3_phi, emulMET_Zee_phi);
-      dPhiJet3Met_Wenu = deltaPhi(jet3_phi, emulMET_Wenu_phi);
-    }
-
-
-    // Define deltaPhi(Jet_i,MET) cut and Central Jet Veto (CJV)
-    if (m_goodJet->size() > 0) {
-
-      // loop over the jets in the Good Jets Container
-      for (const auto& jet : *m_goodJet) {
-        float good_jet_pt = jet->pt();
-        float good_jet_rapidity = jet->rapidity();
-        float good_jet_phi = jet->phi();
-
-        // Calculate dPhi(Jet_i,MET) and dPhi_min(Jet_i,MET)
-        if (m_goodJet->at(0) == jet || m_goodJet->at(1) == jet || m_goodJet->at(2) == jet || m_goodJet->at(3) == jet){ // apply cut only to leading jet1, jet2, jet3 and jet4
-          // For Znunu
-          if (m_isZnunu){
-            float dPhijetmet = deltaPhi(good_jet_phi,MET_phi);
-            //Info("execute()", " [Znunu] Event # = %llu", eventInfo->eventNumber());
-            //Info("execute()", " [Znunu] dPhi = %.2f", dPhijetmet);
-            if ( good_jet_pt > 30000. && fabs(good_jet_rapidity) < 4.4 && dPhijetmet < 0.4 ) pass_dPhijetmet = false;
-            dPhiMinjetmet = std::min(dPhiMinjetmet, dPhijetmet);
-            //Info("execute()", " [Znunu] dPhi_min = %.2f", dPhiMinjetmet);
-          }
-          // For Zmumu
-          if (m_isZmumu){
-            float dPhijetmet_Zmumu = deltaPhi(good_jet_phi,emulMET_Zmumu_phi);
-            //Info("execute()", " [Zmumu] Event # = %llu", eventInfo->eventNumber());
-            //Info("execute()", " [Zmumu] dPhi = %.2f", dPhijetmet_Zmumu);
-            if ( good_jet_pt > 30000. && fabs(good_jet_rapidity) < 4.4 && dPhijetmet_Zmumu < 0.4 ) pass_dPhijetmet_Zmumu = false;
-            dPhiMinjetmet_Zmumu = std::min(dPhiMinjetmet_Zmumu, dPhijetmet_Zmumu);
-            //Info("execute()", " [Zmumu] dPhi_min = %.2f", dPhiMinjetmet_Zmumu);
-          }
-          // For Wmunu
-          if (m_isWmunu){
-            float dPhijetmet_Wmunu = deltaPhi(good_jet_phi,emulMET_Wmunu_phi);
-            //Info("execute()", " [Wmunu] Event # = %llu", eventInfo->eventNumber());
-            //Info("execute()", " [Wmunu] dPhi = %.2f", dPhijetmet_Wmunu);
-            if ( good_jet_pt > 30000. && fabs(good_jet_rapidity) < 4.4 && dPhijetmet_Wmunu < 0.4 ) pass_dPhijetmet_Wmunu = false;
-            dPhiMinjetmet_Wmunu = std::min(dPhiMinjetmet_Wmunu, dPhijetmet_Wmunu);
-            //Info("execute()", " [Wmunu] dPhi_min = %.2f", dPhiMinjetmet_Wmunu);
-          }
-          // For Zee
-          if (m_isZee){
-            float dPhijetmet_Zee = deltaPhi(good_jet_phi,emulMET_Zee_phi);
-            //Info("execute()", " [Zee] Event # = %llu", eventInfo->eventNumber());
-            //Info("execute()", " [Zee] dPhi = %.2f", dPhijetmet_Zee);
-            if ( good_jet_pt > 30000. && fabs(good_jet_rapidity) < 4.4 && dPhijetmet_Zee < 0.4 ) pass_dPhijetmet_Zee = false;
-            dPhiMinjetmet_Zee = std::min(dPhiMinjetmet_Zee, dPhijetmet_Zee);
-            //Info("execute()", " [Zee] dPhi_min = %.2f", dPhiMinjetmet_Zee);
-          }
-          // For Wenu
-          if (m_isWenu){
-            float dPhijetmet_Wenu = deltaPhi(good_jet_phi,emulMET_Wenu_phi);
-            //Info("execute()", " [Wenu] Event # = %llu", eventInfo->eventNumber());
-            //Info("execute()", " [Wenu] dPhi = %.2f", dPhijetmet_Wenu);
-            if ( good_jet_pt > 30000. && fabs(good_jet_rapidity) < 4.4 && dPhijetmet_Wenu < 0.4 ) pass_dPhijetmet_Wenu = false;
-            dPhiMinjetmet_Wenu = std::min(dPhiMinjetmet_Wenu, dPhijetmet_Wenu);
-            //Info("execute()", " [Wenu] dPhi_min = %.2f", dPhiMinjetmet_Wenu);
-          }
-        }
+      dPhiJet3Met_Zmumu = deltaPhi(jet3_phi, emulMET_Zmumu_phi);
+      dPhiJet3Met_Wmunu = deltaPhi(jet3_phi, emulMET_Wmunu_phi);
+      dPhiJet3Met_Zee = deltaPhi(jet3_phi, emulMET_Zee_phi);
+      dPhiJet3Met_Wenu = deltaPhi(jet3_phi, emulMET_Wenu_phi);
+    }
 
-        // Central Jet Veto (CJV)
-        if ( m_goodJet->size() > 2 && pass_diJet ){
-          if (m_goodJet->at(0) != jet && m_goodJet->at(1) != jet){
-            //cout << "m_goodJet->at(0) = " << m_goodJet->at(0) << " jet = " << jet << endl;
-            if (good_jet_pt > m_CJVptCut && fabs(good_jet_rapidity) < m_diJetRapCut) {
-              if ( (jet1_rapidity > jet2_rapidity) && (good_jet_rapidity < jet1_rapidity && good_jet_rapidity > jet2_rapidity)){
-                pass_CJV = false;
-              }
-              if ( (jet1_rapidity < jet2_rapidity) && (good_jet_rapidity > jet1_rapidity && good_jet_rapidity < jet2_rapidity)){
-                pass_CJV = false;
-              }
-              /* //Valentinos' way (same result as mine)
-              float rapLow  = std::min(jet1_rapidity, jet2_rapidity);
-              float rapHigh = std::max(jet1_rapidity, jet2_rapidity);
-              if (good_jet_rapidity > rapLow && good_jet_rapidity < rapHigh) pass_CJV = false;
-              */
-            }
-          }
-        }
 
-        //Info("execute()", "  Znunu Signal Jet pt = %.2f GeV, eta = %.2f", good_pt_jet * 0.001, good_eta_jet);
-        goodJet_ht += good_jet_pt;
-      } // Jet loop
+    // deltaPhi(Jet_i,MET) cut of the leading jet1, jet2, jet3 and jet4
+    pass_dPhijetmet = jetTopo.passDPhiJetMet[kMetZnunu];
+    pass_dPhijetmet_Zmumu = jetTopo.passDPhiJetMet[kMetZmumu];
+    pass_dPhijetmet_Wmunu = jetTopo.passDPhiJetMet[kMetWmunu];
+    pass_dPhijetmet_Zee = jetTopo.passDPhiJetMet[kMetZee];
+    pass_dPhijetmet_Wenu = jetTopo.passDPhiJetMet[kMetWenu];
+    dPhiMinjetmet = jetTopo.dPhiMinJetMet[kMetZnunu];
+    dPhiMinjetmet_Zmumu = jetTopo.dPhiMinJetMet[kMetZmumu];
+    dPhiMinjetmet_Wmunu = jetTopo.dPhiMinJetMet[kMetWmunu];
+    dPhiMinjetmet_Zee = jetTopo.dPhiMinJetMet[kMetZee];
+    dPhiMinjetmet_Wenu = jetTopo.dPhiMinJetMet[kMetWenu];
 
-    } // End deltaPhi(Jet_i,MET) cut and Central Jet Veto (CJV)
+    // Central Jet Veto (CJV)
+    if (pass_diJet && jetTopo.centralJet) pass_CJV = false;
+
+    goodJet_ht = jetTopo.ht;
 
 
 
     ////////////////////
     // bJet Selection //
     ////////////////////
-    int n_bJet = 0;
-    if (m_goodJet->size() > 0) {
-      // loop over the jets in the Good Jets Container
-      for (const auto& jet : *m_goodJet) {
-        //Info("execute()", "  jet pt = %.2f GeV", jet->pt() * 0.001);
-        if (m_BJetSelectTool->accept(*jet)) {
-          n_bJet ++;
-          //Info("execute()", "  bJet pt = %.2f GeV", jet->pt() * 0.001);
-        }
-      }
-    }
+    // b-tagging decision taken in the object snapshot
+    int n_bJet = m_jetStore.CountFlag(kFlagBTagged);
     //Info("execute()", "  # bJet = %i", n_bJet);
 
 
@@ -4117,12 +4256,12 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     ///////////////////
     // SM1 Selection //
     ///////////////////
-    if (m_goodJet->size() > 0) {
+    if (jetTopo.nJets > 0) {
 
-      sm1jet_pt = m_goodJet->at(0)->pt();
-      sm1jet_phi = m_goodJet->at(0)->phi();
-      sm1jet_eta = m_goodJet->at(0)->eta();
-      sm1jet_rapidity = m_goodJet->at(0)->rapidity();
+      sm1jet_pt = m_jetStore.Pt(0);
+      sm1jet_phi = m_jetStore.Phi(0);
+      sm1jet_eta = m_jetStore.Eta(0);
+      sm1jet_rapidity = m_jetStore.Rapidity(0);
 
       // Define SM1jet
       if ( sm1jet_pt > m_sm1JetPtCut ){
@@ -4132,40 +4271,13 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
         }
       }
 
-      // loop over the jets in the Good Jets Container
-      if (pass_sm1Jet) {
-        for (const auto& jet : *m_goodJet) {
-          uint sm1jet_index = m_goodJet->at(0)->index(); // index for leading jet in SM1
-          if (jet->index() != sm1jet_index) { // For subleading jets in SM1
-            if (jet->pt() > 30000.) pass_sm1Jet = false; // Subleading jets in SM1 should not be greater than 30GeV
-          }
-        }
-      }
-
-      /* // Test SM1 jets
-      if (pass_sm1Jet) {
-        Info("execute()", " [SM1] Event # = %llu", eventInfo->eventNumber());
-        for (const auto& jet : *m_goodJet) {
-          Info("execute()", " [SM1] Jet_pt = %.2f GeV ", jet->pt()*0.001);
-        }
-      }
-      */
-
-
-      // deltaPhi(sm1jet,MET) decision
+      // Subleading jets in SM1 should not be greater than 30GeV
+      if (jetTopo.subleadingJet) pass_sm1Jet = false;
 
-      // For Znunu
-      if (m_isZnunu){
-        dPhiSM1jetMet = deltaPhi(sm1jet_phi, MET_phi);
-      }
-      // For Zmumu
-      if (m_isZmumu){
-        dPhiSM1jetMet_Zmumu = deltaPhi(sm1jet_phi, emulMET_Zmumu_phi);
-      }
-      // For Zee
-      if (m_isZee){
-        dPhiSM1jetMet_Zee = deltaPhi(sm1jet_phi, emulMET_Zee_phi);
-      }
+      // deltaPhi(sm1jet,MET) decision (0 for the channels not enabled)
+      dPhiSM1jetMet = jetTopo.dPhiJetMet[kMetZnunu][0];
+      dPhiSM1jetMet_Zmumu = jetTopo.dPhiJetMet[kMetZmumu][0];
+      dPhiSM1jetMet_Zee = jetTopo.dPhiJetMet[kMetZee][0];
 
     } // SM1 selection 
 
@@ -4195,14 +4307,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       // For Zmumu Selection
       if (m_goodMuonForZ->size() > 1) {
 
-        TLorentzVector muon1 = m_goodMuonForZ->at(0)->p4();
-        TLorentzVector muon2 = m_goodMuonForZ->at(1)->p4();
-        muon1_pt = m_goodMuonForZ->at(0)->pt();
-        muon2_pt = m_goodMuonForZ->at(1)->pt();
-        muon1_charge = m_goodMuonForZ->at(0)->charge();
-        muon2_charge = m_goodMuonForZ->at(1)->charge();
-        auto Zmass_muon = muon1 + muon2;
-        mll_muon = Zmass_muon.M();
+        muon1_pt = m_muonForZStore.Pt(0);
+        muon2_pt = m_muonForZStore.Pt(1);
+        muon1_charge = m_muonForZStore.Charge(0);
+        muon2_charge = m_muonForZStore.Charge(1);
+        mll_muon = m_muonForZStore.Mass(0, 1);
 
         //Info("execute()", "  muon1 = %.2f GeV, muon2 = %.2f GeV", muon1_pt * 0.001, muon2_pt * 0.001);
         //Info("execute()", "  mll (Zmumu) = %.2f GeV", mll_muon * 0.001);
@@ -4212,10 +4321,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
         if ( muon1_charge * muon2_charge > 0 ) pass_SSmuon = true;
         //Info("execute()", "  muon1 charge = %f, muon2 charge = %f, pass_OSmuon = %d, pass_SSmuon = %d", muon1_charge, muon2_charge, pass_OSmuon, pass_SSmuon);
 
-        uint index1 = m_goodMuonForZ->at(0)->index();
-        uint index2 = m_goodMuonForZ->at(1)->index();
-        for (const auto &muon : *m_goodMuon) {
-          if (muon->index() != index1 && muon->index() != index2) numExtra++;
+        uint index1 = m_muonForZStore.Index(0);
+        uint index2 = m_muonForZStore.Index(1);
+        for (unsigned int i = 0; i < m_muonStore.Size(); i++) {
+          if (m_muonStore.Index(i) != index1 && m_muonStore.Index(i) != index2) numExtra++;
           //std::cout << muon->index() << " " << index1 << " " << index2 << std::endl;
         }
 
@@ -4231,9 +4340,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     if (m_isWmunu) {
       // Wmunu Selection
       if (m_goodMuon->size() == 1) {
-        float muon_pt = m_goodMuon->at(0)->pt();
-        float muon_phi = m_goodMuon->at(0)->phi();
-        mT_muon = TMath::Sqrt( 2. * muon_pt * MET * ( 1. - TMath::Cos(muon_phi - MET_phi) ) );
+        float muon_pt = m_muonStore.Pt(0);
+        float muon_phi = m_muonStore.Phi(0);
+        mT_muon = TransverseMass(muon_pt, muon_phi, MET, MET_phi);
 
         if ( muon_pt > 25000. ){
           pass_Wmunu = true;
@@ -4263,14 +4372,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       // Zee Selection
       if (m_goodElectron->size() > 1) {
 
-        TLorentzVector electron1 = m_goodElectron->at(0)->p4();
-        TLorentzVector electron2 = m_goodElectron->at(1)->p4();
-        electron1_pt = m_goodElectron->at(0)->pt();
-        electron2_pt = m_goodElectron->at(1)->pt();
-        electron1_charge = m_goodElectron->at(0)->charge();
-        electron2_charge = m_goodElectron->at(1)->charge();
-        auto Zmass_electron = electron1 + electron2;
-        mll_electron = Zmass_electron.M();
+        electron1_pt = m_electronStore.Pt(0);
+        electron2_pt = m_electronStore.Pt(1);
+        electron1_charge = m_electronStore.Charge(0);
+        electron2_charge = m_electronStore.Charge(1);
+        mll_electron = m_electronStore.Mass(0, 1);
 
         //Info("execute()", "  electron1 = %.2f GeV, electron2 = %.2f GeV", electron1_pt * 0.001, electron2_pt * 0.001);
         //Info("execute()", "  mll (Zee) = %.2f GeV", mll_electron * 0.001);
@@ -4293,9 +4399,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
       // Wenu Selection
       if (m_goodElectron->size() == 1) {
-        float electron_pt = m_goodElectron->at(0)->pt();
-        float electron_phi = m_goodElectron->at(0)->phi();
-        mT_electron = TMath::Sqrt( 2. * electron_pt * MET * ( 1. - TMath::Cos(electron_phi - MET_phi) ) );
+        float electron_pt = m_electronStore.Pt(0);
+        float electron_phi = m_electronStore.Phi(0);
+        mT_electron = TransverseMass(electron_pt, electron_phi, MET, MET_phi);
 
         if ( electron_pt > 25000. ){
           pass_Wenu = true;
@@ -4310,22 +4416,14 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // ------------------
     // Get isolated track
     // ------------------
-    /*
-    // Retrieve main TrackParticle collection
-    const xAOD::TrackParticleContainer* inTracks(0);
-    if ( !m_event->retrieve( inTracks, "InDetTrackParticles" ).isSuccess() ){ // retrieve arguments: container type, container key
-    Error("execute()", "Failed to retrieve TrackParticle container. Exiting." );
-    return EL::StatusCode::FAILURE;
-    }
-
-    int Nisotrk = NumIsoTracks(inTracks, primVertex, 3., 10.) - NumMuonIsoTrack(muonSC, inTracks, primVertex, 3., 10.) - NumElecIsoTrack(elecSC, inTracks, primVertex, 3., 10.);
-
     bool passIsoTrk = true;
-    if (Nisotrk > 0) {
-    passIsoTrk = false;
-    //Info("execute()", "  The number of Isolated track counted = %i (N_SignalMuon = %lu, N_SignalElec = %lu)", Nisotrk, m_goodMuon->size(), m_goodElectron->size() );
+    if (m_doIsoTrackVeto) {
+      int Nisotrk = NisoTrackEvent - NumMuonIsoTrack(muonSC, 3., 10.) - NumElecIsoTrack(elecSC, 3., 10.);
+      if (Nisotrk > 0) {
+        passIsoTrk = false;
+        //Info("execute()", "  The number of Isolated track counted = %i (N_SignalMuon = %lu, N_SignalElec = %lu)", Nisotrk, m_goodMuon->size(), m_goodElectron->size() );
+      }
     }
-    */
 
 
 
@@ -4338,52 +4436,53 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //-------------------------------
 
     if (m_isZnunu){
-      h_channel = "h_znunu_";
+      m_histChannel = kChZnunu;
       if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu]MET Trigger");
+        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuMETTrigger);
         if (sysName == "" && m_useArrayCutflow) m_eventCutflow[5]+=1;
         if ( MET > m_metCut ) {
-          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu]MET cut");
+          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuMETCut);
           if (sysName == "" && m_useArrayCutflow) m_eventCutflow[6]+=1;
           if (m_goodElectron->size() == 0) {
-            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu]Electron Veto");
+            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuElectronVeto);
             if (sysName == "" && m_useArrayCutflow) m_eventCutflow[7]+=1;
             if ( m_goodMuon->size() == 0) {
-              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu]Muon Veto");
+              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuMuonVeto);
               if (sysName == "" && m_useArrayCutflow) m_eventCutflow[8]+=1;
-              if (m_goodTau->size() == 0) {
-                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu]Tau Veto");
+              if (m_goodTau->size() == 0 && passIsoTrk) { // isolated track veto for the taus missed by the tau ID
+                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuTauVeto);
                 if (sysName == "" && m_useArrayCutflow) m_eventCutflow[9]+=1;
                 if ( m_goodJet->size() > 0 ) {
-                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu]At least One Jets");
+                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuAtLeastOneJets);
                   if (sysName == "" && m_useArrayCutflow) m_eventCutflow[10]+=1;
 
                   ////////////////////////
                   // MonoJet phasespace //
                   ////////////////////////
                   if ( pass_monoJet ) {
-                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu, monojet]MonoJet");
+                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuMonojetMonoJet);
                     if ( pass_dPhijetmet ) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu, monojet]dPhi(jet_i,MET) cut");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuMonojetDPhiJetMETCut);
 
                       // Fill histogram
                       // For Ratio plot (Blind MET and Mjj for Ratio)
                       if (MET < m_METblindcut) {
-                        hMap1D["Znunu_MET_mono"+sysName]->Fill(MET * 0.001, mcEventWeight);
+                        m_histRegistry->Fill(kChZnunu, kRegRatio, kVar_MET_mono, m_histSys, MET * 0.001, mcEventWeight, kWeightEvent);
                       }
                       // For publication
-                      hMap1D[h_channel+"monojet_met"+sysName]->Fill(MET * 0.001, mcEventWeight);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met, m_histSys, MET * 0.001, mcEventWeight, kWeightEvent);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_cst, m_histSys, MET_CST * 0.001, mcEventWeight, kWeightEvent);
                       // Average Interaction
-                      hMap1D[h_channel+"monojet_avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight, kWeightEvent);
                       if (sysName == ""){
                         // Jets
-                        hMap1D[h_channel+"monojet_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight);
-                        hMap1D[h_channel+"monojet_jet_pt"+sysName]->Fill(monojet_pt * 0.001, mcEventWeight);
-                        hMap1D[h_channel+"monojet_jet_phi"+sysName]->Fill(monojet_phi, mcEventWeight);
-                        hMap1D[h_channel+"monojet_jet_eta"+sysName]->Fill(monojet_eta, mcEventWeight);
-                        hMap1D[h_channel+"monojet_jet_rap"+sysName]->Fill(monojet_rapidity, mcEventWeight);
-                        hMap1D[h_channel+"monojet_dPhimetjet"+sysName]->Fill(dPhiMonojetMet, mcEventWeight);
-                        hMap1D[h_channel+"monojet_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet, mcEventWeight);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight, kWeightEvent);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_pt, m_histSys, monojet_pt * 0.001, mcEventWeight, kWeightEvent);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_phi, m_histSys, monojet_phi, mcEventWeight, kWeightEvent);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_eta, m_histSys, monojet_eta, mcEventWeight, kWeightEvent);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_rap, m_histSys, monojet_rapidity, mcEventWeight, kWeightEvent);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_dPhimetjet, m_histSys, dPhiMonojetMet, mcEventWeight, kWeightEvent);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet, mcEventWeight, kWeightEvent);
                       }
 
                     } // pass dPhijetmet
@@ -4393,52 +4492,53 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                   // VBF phasespace //
                   ////////////////////
                   if ( pass_diJet ) {
-                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu, VBF]DiJet");
+                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuVBFDiJet);
                     if (sysName == "" && m_useArrayCutflow) m_eventCutflow[11]+=1;
                     if ( mjj > m_mjjCut ) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu, VBF]mjj cut");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuVBFMjjCut);
                       if (sysName == "" && m_useArrayCutflow) m_eventCutflow[12]+=1;
                       if ( pass_CJV ) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu, VBF]CJV cut");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuVBFCJVCut);
                         if (sysName == "" && m_useArrayCutflow) m_eventCutflow[13]+=1;
                         if ( pass_dPhijetmet ) {
-                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Znunu, VBF]dPhi(jet_i,MET) cut");
+                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZnunuVBFDPhiJetMETCut);
                           if (sysName == "" && m_useArrayCutflow) m_eventCutflow[14]+=1;
                           // Fill histogram
                           // For Ratio plot (Blind MET and Mjj for Ratio)
                           if (MET < m_METblindcut && mjj < m_Mjjblindcut) {
-                            hMap1D["Znunu_MET_search"+sysName]->Fill(MET * 0.001, mcEventWeight);
-                            hMap1D["Znunu_Mjj_search"+sysName]->Fill(mjj * 0.001, mcEventWeight);
-                            hMap1D["Znunu_DeltaPhiAll"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight);
+                            m_histRegistry->Fill(kChZnunu, kRegRatio, kVar_MET_search, m_histSys, MET * 0.001, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(kChZnunu, kRegRatio, kVar_Mjj_search, m_histSys, mjj * 0.001, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(kChZnunu, kRegRatio, kVar_DeltaPhiAll, m_histSys, dPhijj, mcEventWeight, kWeightEvent);
                           }
                           // For publication
-                          hMap1D[h_channel+"vbf_met"+sysName]->Fill(MET * 0.001, mcEventWeight);
-                          hMap1D[h_channel+"vbf_mjj"+sysName]->Fill(mjj * 0.001, mcEventWeight);
-                          hMap1D[h_channel+"vbf_dPhijj"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight);
+                          m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met, m_histSys, MET * 0.001, mcEventWeight, kWeightEvent);
+                          m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_cst, m_histSys, MET_CST * 0.001, mcEventWeight, kWeightEvent);
+                          m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj, m_histSys, mjj * 0.001, mcEventWeight, kWeightEvent);
+                          m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj, m_histSys, dPhijj, mcEventWeight, kWeightEvent);
                           // Average Interaction
-                          hMap1D[h_channel+"vbf_avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight);
+                          m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight, kWeightEvent);
                           if (sysName == ""){
                             // Jets
-                            hMap1D[h_channel+"vbf_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet1_pt"+sysName]->Fill(jet1_pt * 0.001, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet2_pt"+sysName]->Fill(jet2_pt * 0.001, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet1_phi"+sysName]->Fill(jet1_phi, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet2_phi"+sysName]->Fill(jet2_phi, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet1_eta"+sysName]->Fill(jet1_eta, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet2_eta"+sysName]->Fill(jet2_eta, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet1_rap"+sysName]->Fill(jet1_rapidity, mcEventWeight);
-                            hMap1D[h_channel+"vbf_jet2_rap"+sysName]->Fill(jet2_rapidity, mcEventWeight);
-                            hMap1D[h_channel+"vbf_dRjj"+sysName]->Fill(deltaR(jet1_eta, jet2_eta, jet1_phi, jet2_phi), mcEventWeight);
-                            hMap1D[h_channel+"vbf_dPhimetj1"+sysName]->Fill(dPhiJet1Met, mcEventWeight);
-                            hMap1D[h_channel+"vbf_dPhimetj2"+sysName]->Fill(dPhiJet2Met, mcEventWeight);
-                            hMap1D[h_channel+"vbf_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet, mcEventWeight);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_pt, m_histSys, jet1_pt * 0.001, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_pt, m_histSys, jet2_pt * 0.001, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_phi, m_histSys, jet1_phi, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_phi, m_histSys, jet2_phi, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_eta, m_histSys, jet1_eta, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_eta, m_histSys, jet2_eta, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_rap, m_histSys, jet1_rapidity, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_rap, m_histSys, jet2_rapidity, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dRjj, m_histSys, dRjj, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj1, m_histSys, dPhiJet1Met, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj2, m_histSys, dPhiJet2Met, mcEventWeight, kWeightEvent);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet, mcEventWeight, kWeightEvent);
                             // For jet3
                             if (m_goodJet->size() > 2){
-                              hMap1D[h_channel+"vbf_jet3_pt"+sysName]->Fill(jet3_pt * 0.001, mcEventWeight);
-                              hMap1D[h_channel+"vbf_jet3_phi"+sysName]->Fill(jet3_phi, mcEventWeight);
-                              hMap1D[h_channel+"vbf_jet3_eta"+sysName]->Fill(jet3_eta, mcEventWeight);
-                              hMap1D[h_channel+"vbf_jet3_rap"+sysName]->Fill(jet3_rapidity, mcEventWeight);
-                              hMap1D[h_channel+"vbf_dPhimetj3"+sysName]->Fill(dPhiJet3Met, mcEventWeight);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_pt, m_histSys, jet3_pt * 0.001, mcEventWeight, kWeightEvent);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_phi, m_histSys, jet3_phi, mcEventWeight, kWeightEvent);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_eta, m_histSys, jet3_eta, mcEventWeight, kWeightEvent);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_rap, m_histSys, jet3_rapidity, mcEventWeight, kWeightEvent);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj3, m_histSys, dPhiJet3Met, mcEventWeight, kWeightEvent);
                             }
                           }
 
@@ -4518,36 +4618,36 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //---------------------------------
 
     if (m_isZmumu){
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
       if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]MET Trigger");
+        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuMETTrigger);
         if (sysName == "" && m_useArrayCutflow) m_eventCutflow[16]+=1;
         if ( emulMET_Zmumu > m_metCut ) {
-          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]MET cut");
+          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuMETCut);
           if (sysName == "" && m_useArrayCutflow) m_eventCutflow[17]+=1;
           if (m_goodElectron->size() == 0) {
-            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]Electron Veto");
+            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuElectronVeto);
             if (sysName == "" && m_useArrayCutflow) m_eventCutflow[18]+=1;
             if ( m_goodMuonForZ->size() > 1) {
-              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]At least Two Muons");
+              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuAtLeastTwoMuons);
               if (sysName == "" && m_useArrayCutflow) m_eventCutflow[19]+=1;
               if (m_goodTau->size() == 0) {
-                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]Tau Veto");
+                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuTauVeto);
                 if (sysName == "" && m_useArrayCutflow) m_eventCutflow[20]+=1;
                 if ( pass_dimuonPtCut && pass_OSmuon && numExtra == 0 && mll_muon > m_mllMin && mll_muon < m_mllMax ){
-                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]mll cut");
+                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuMllCut);
                   if (sysName == "" && m_useArrayCutflow) m_eventCutflow[21]+=1;
                   if ( m_goodJet->size() > 0 ) {
-                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu]At least One Jets");
+                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuAtLeastOneJets);
                     if (sysName == "" && m_useArrayCutflow) m_eventCutflow[22]+=1;
 
                     ////////////////////////
                     // MonoJet phasespace //
                     ////////////////////////
                     if ( pass_monoJet ) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu, monojet]MonoJet");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuMonojetMonoJet);
                       if ( pass_dPhijetmet_Zmumu ) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu, monojet]dPhi(jet_i,MET) cut");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuMonojetDPhiJetMETCut);
 
                         // Calculate muon SF for Zmumu
                         float mcEventWeight_Zmumu = 1.;
@@ -4560,38 +4660,39 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                         // Fill histogram
                         // For Ratio plot (Blind MET and Mjj for Ratio)
                         if (emulMET_Zmumu < m_METblindcut) {
-                          hMap1D["Zmumu_MET_mono"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                          m_histRegistry->Fill(kChZmumu, kRegRatio, kVar_MET_mono, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                         }
                         // For publication
-                        hMap1D[h_channel+"monojet_met_emulmet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet_cst, m_histSys, emulMET_Zmumu_CST * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                         // Average Interaction
-                        hMap1D[h_channel+"monojet_avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight_Zmumu);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight_Zmumu, kWeightMuon);
 
                         // For top enhanced control region
                         if (n_bJet > 0) { // At least 1 bJet
-                          hMap1D[h_channel+"monojet_met_emulmet_1bJet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet_1bJet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                         }
                         if (n_bJet > 1) { // At least 2 bJet
-                          hMap1D[h_channel+"monojet_met_emulmet_2bJet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet_2bJet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                         }
 
                         if (sysName == ""){
                           // Jets
-                          hMap1D[h_channel+"monojet_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_jet_pt"+sysName]->Fill(monojet_pt * 0.001, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_jet_phi"+sysName]->Fill(monojet_phi, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_jet_eta"+sysName]->Fill(monojet_eta, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_jet_rap"+sysName]->Fill(monojet_rapidity, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_dPhimetjet"+sysName]->Fill(dPhiMonojetMet_Zmumu, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet_Zmumu, mcEventWeight_Zmumu);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_pt, m_histSys, monojet_pt * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_phi, m_histSys, monojet_phi, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_eta, m_histSys, monojet_eta, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_rap, m_histSys, monojet_rapidity, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_dPhimetjet, m_histSys, dPhiMonojetMet_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
                           // Leptons
-                          hMap1D[h_channel+"monojet_lepton1_pt"+sysName]->Fill(m_goodMuonForZ->at(0)->pt() * 0.001, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_lepton2_pt"+sysName]->Fill(m_goodMuonForZ->at(1)->pt() * 0.001, mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_lepton1_phi"+sysName]->Fill(m_goodMuonForZ->at(0)->phi(), mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_lepton2_phi"+sysName]->Fill(m_goodMuonForZ->at(1)->phi(), mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_lepton1_eta"+sysName]->Fill(m_goodMuonForZ->at(0)->eta(), mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_lepton2_eta"+sysName]->Fill(m_goodMuonForZ->at(1)->eta(), mcEventWeight_Zmumu);
-                          hMap1D[h_channel+"monojet_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton1_pt, m_histSys, m_muonForZStore.Pt(0) * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton2_pt, m_histSys, m_muonForZStore.Pt(1) * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton1_phi, m_histSys, m_muonForZStore.Phi(0), mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton2_phi, m_histSys, m_muonForZStore.Phi(1), mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton1_eta, m_histSys, m_muonForZStore.Eta(0), mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton2_eta, m_histSys, m_muonForZStore.Eta(1), mcEventWeight_Zmumu, kWeightMuon);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                         }
 
                       } // pass dPhijetmet_Zmumu
@@ -4601,16 +4702,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                     // VBF phasespace //
                     ////////////////////
                     if ( pass_diJet ) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu, VBF]DiJet");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuVBFDiJet);
                       if (sysName == "" && m_useArrayCutflow) m_eventCutflow[23]+=1;
                       if ( mjj > m_mjjCut ) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu, VBF]mjj cut");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuVBFMjjCut);
                         if (sysName == "" && m_useArrayCutflow) m_eventCutflow[24]+=1;
                         if ( pass_CJV ) {
-                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu, VBF]CJV cut");
+                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuVBFCJVCut);
                           if (sysName == "" && m_useArrayCutflow) m_eventCutflow[25]+=1;
                           if ( pass_dPhijetmet_Zmumu ) {
-                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zmumu, VBF]dPhi(jet_i,MET) cut");
+                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZmumuVBFDPhiJetMETCut);
                             if (sysName == "" && m_useArrayCutflow) m_eventCutflow[26]+=1;
 
                             // Calculate muon SF for Zmumu
@@ -4624,60 +4725,61 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                             // Fill histogram
                             // For Ratio plot (Blind MET and Mjj for Ratio)
                             if (emulMET_Zmumu < m_METblindcut && mjj < m_Mjjblindcut) {
-                              hMap1D["Zmumu_MET_search"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                              hMap1D["Zmumu_Mjj_search"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                              hMap1D["Zmumu_DeltaPhiAll"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                              m_histRegistry->Fill(kChZmumu, kRegRatio, kVar_MET_search, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(kChZmumu, kRegRatio, kVar_Mjj_search, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(kChZmumu, kRegRatio, kVar_DeltaPhiAll, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                             }
                             // For publication
-                            hMap1D[h_channel+"vbf_met_emulmet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                            hMap1D[h_channel+"vbf_mjj"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                            hMap1D[h_channel+"vbf_dPhijj"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet_cst, m_histSys, emulMET_Zmumu_CST * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                             // Average Interaction
-                            hMap1D[h_channel+"vbf_avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight_Zmumu);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight_Zmumu, kWeightMuon);
 
                             // For top enhanced control region
                             if (n_bJet > 0) { // At least 1 bJet
-                              hMap1D[h_channel+"vbf_met_emulmet_1bJet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_mjj_1bJet"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_dPhijj_1bJet"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet_1bJet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj_1bJet, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj_1bJet, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                             }
                             if (n_bJet > 1) { // At least 2 bJet
-                              hMap1D[h_channel+"vbf_met_emulmet_2bJet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_mjj_2bJet"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_dPhijj_2bJet"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet_2bJet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj_2bJet, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj_2bJet, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                             }
 
                             if (sysName == ""){
                               // Jets
-                              hMap1D[h_channel+"vbf_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet1_pt"+sysName]->Fill(jet1_pt * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet2_pt"+sysName]->Fill(jet2_pt * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet1_phi"+sysName]->Fill(jet1_phi, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet2_phi"+sysName]->Fill(jet2_phi, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet1_eta"+sysName]->Fill(jet1_eta, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet2_eta"+sysName]->Fill(jet2_eta, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet1_rap"+sysName]->Fill(jet1_rapidity, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_jet2_rap"+sysName]->Fill(jet2_rapidity, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_dRjj"+sysName]->Fill(deltaR(jet1_eta, jet2_eta, jet1_phi, jet2_phi), mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_dPhimetj1"+sysName]->Fill(dPhiJet1Met_Zmumu, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_dPhimetj2"+sysName]->Fill(dPhiJet2Met_Zmumu, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet_Zmumu, mcEventWeight_Zmumu);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_pt, m_histSys, jet1_pt * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_pt, m_histSys, jet2_pt * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_phi, m_histSys, jet1_phi, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_phi, m_histSys, jet2_phi, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_eta, m_histSys, jet1_eta, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_eta, m_histSys, jet2_eta, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_rap, m_histSys, jet1_rapidity, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_rap, m_histSys, jet2_rapidity, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dRjj, m_histSys, dRjj, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj1, m_histSys, dPhiJet1Met_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj2, m_histSys, dPhiJet2Met_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
                               // For jet3
                               if (m_goodJet->size() > 2){
-                                hMap1D[h_channel+"vbf_jet3_pt"+sysName]->Fill(jet3_pt * 0.001, mcEventWeight_Zmumu);
-                                hMap1D[h_channel+"vbf_jet3_phi"+sysName]->Fill(jet3_phi, mcEventWeight_Zmumu);
-                                hMap1D[h_channel+"vbf_jet3_eta"+sysName]->Fill(jet3_eta, mcEventWeight_Zmumu);
-                                hMap1D[h_channel+"vbf_jet3_rap"+sysName]->Fill(jet3_rapidity, mcEventWeight_Zmumu);
-                                hMap1D[h_channel+"vbf_dPhimetj3"+sysName]->Fill(dPhiJet3Met_Zmumu, mcEventWeight_Zmumu);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_pt, m_histSys, jet3_pt * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_phi, m_histSys, jet3_phi, mcEventWeight_Zmumu, kWeightMuon);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_eta, m_histSys, jet3_eta, mcEventWeight_Zmumu, kWeightMuon);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_rap, m_histSys, jet3_rapidity, mcEventWeight_Zmumu, kWeightMuon);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj3, m_histSys, dPhiJet3Met_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
                               }
                               // Leptons
-                              hMap1D[h_channel+"vbf_lepton1_pt"+sysName]->Fill(m_goodMuonForZ->at(0)->pt() * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_lepton2_pt"+sysName]->Fill(m_goodMuonForZ->at(1)->pt() * 0.001, mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_lepton1_phi"+sysName]->Fill(m_goodMuonForZ->at(0)->phi(), mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_lepton2_phi"+sysName]->Fill(m_goodMuonForZ->at(1)->phi(), mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_lepton1_eta"+sysName]->Fill(m_goodMuonForZ->at(0)->eta(), mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_lepton2_eta"+sysName]->Fill(m_goodMuonForZ->at(1)->eta(), mcEventWeight_Zmumu);
-                              hMap1D[h_channel+"vbf_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton1_pt, m_histSys, m_muonForZStore.Pt(0) * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton2_pt, m_histSys, m_muonForZStore.Pt(1) * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton1_phi, m_histSys, m_muonForZStore.Phi(0), mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton2_phi, m_histSys, m_muonForZStore.Phi(1), mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton1_eta, m_histSys, m_muonForZStore.Eta(0), mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton2_eta, m_histSys, m_muonForZStore.Eta(1), mcEventWeight_Zmumu, kWeightMuon);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                             }
 
 
@@ -4741,36 +4843,36 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //-------------------------------
 
     if (m_isZee){
-      h_channel = "h_zee_";
+      m_histChannel = kChZee;
       if ((!m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM18VH")) || (m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM20VH")) || m_trigDecisionTool->isPassed("HLT_e60_lhmedium") || m_trigDecisionTool->isPassed("HLT_e120_lhloose")){
-        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]Electron Trigger");
+        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeElectronTrigger);
         if (sysName == "" && m_useArrayCutflow) m_eventCutflow[28]+=1;
         if ( emulMET_Zee > m_metCut ) {
-          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]MET cut");
+          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeMETCut);
           if (sysName == "" && m_useArrayCutflow) m_eventCutflow[29]+=1;
           if (m_goodElectron->size() > 1) {
-            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]At least Two Electron");
+            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeAtLeastTwoElectron);
             if (sysName == "" && m_useArrayCutflow) m_eventCutflow[30]+=1;
             if ( m_goodMuon->size() == 0) {
-              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]Muon Veto");
+              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeMuonVeto);
               if (sysName == "" && m_useArrayCutflow) m_eventCutflow[31]+=1;
               if (m_goodTau->size() == 0) {
-                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]Tau Veto");
+                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeTauVeto);
                 if (sysName == "" && m_useArrayCutflow) m_eventCutflow[32]+=1;
                 if ( pass_dielectronPtCut && pass_OSelectron && m_goodElectron->size() == 2 && mll_electron > m_mllMin && mll_electron < m_mllMax ) {
-                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]mll cut");
+                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeMllCut);
                   if (sysName == "" && m_useArrayCutflow) m_eventCutflow[33]+=1;
                   if ( m_goodJet->size() > 0 ) {
-                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee]At least One Jets");
+                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeAtLeastOneJets);
                     if (sysName == "" && m_useArrayCutflow) m_eventCutflow[34]+=1;
 
                     ////////////////////////
                     // MonoJet phasespace //
                     ////////////////////////
                     if ( pass_monoJet ) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee, monojet]MonoJet");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeMonojetMonoJet);
                       if ( pass_dPhijetmet_Zee ) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee, monojet]dPhi(jet_i,MET) cut");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeMonojetDPhiJetMETCut);
 
                         // Calculate electron SF
                         float mcEventWeight_Zee = 1.;
@@ -4783,38 +4885,39 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                         // Fill histogram
                         // For Ratio plot (Blind MET and Mjj)
                         if (emulMET_Zee < m_METblindcut) {
-                          hMap1D["Zee_MET_mono"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                          m_histRegistry->Fill(kChZee, kRegRatio, kVar_MET_mono, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                         }
                         // For publication
-                        hMap1D[h_channel+"monojet_met_emulmet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet_cst, m_histSys, emulMET_Zee_CST * 0.001, mcEventWeight_Zee, kWeightElectron);
                         // Average Interaction
-                        hMap1D[h_channel+"monojet_avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight_Zee);
+                        m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight_Zee, kWeightElectron);
 
                         // For top enhanced control region
                         if (n_bJet > 0) { // At least 1 bJet
-                          hMap1D[h_channel+"monojet_met_emulmet_1bJet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet_1bJet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                         }
                         if (n_bJet > 1) { // At least 2 bJet
-                          hMap1D[h_channel+"monojet_met_emulmet_2bJet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_met_emulmet_2bJet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                         }
 
                         if (sysName == ""){
                           // Jets
-                          hMap1D[h_channel+"monojet_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_jet_pt"+sysName]->Fill(monojet_pt * 0.001, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_jet_phi"+sysName]->Fill(monojet_phi, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_jet_eta"+sysName]->Fill(monojet_eta, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_jet_rap"+sysName]->Fill(monojet_rapidity, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_dPhimetjet"+sysName]->Fill(dPhiMonojetMet_Zee, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet_Zee, mcEventWeight_Zee);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_pt, m_histSys, monojet_pt * 0.001, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_phi, m_histSys, monojet_phi, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_eta, m_histSys, monojet_eta, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_jet_rap, m_histSys, monojet_rapidity, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_dPhimetjet, m_histSys, dPhiMonojetMet_Zee, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet_Zee, mcEventWeight_Zee, kWeightElectron);
                           // Leptons
-                          hMap1D[h_channel+"monojet_lepton1_pt"+sysName]->Fill(m_goodElectron->at(0)->pt() * 0.001, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_lepton2_pt"+sysName]->Fill(m_goodElectron->at(1)->pt() * 0.001, mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_lepton1_phi"+sysName]->Fill(m_goodElectron->at(0)->phi(), mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_lepton2_phi"+sysName]->Fill(m_goodElectron->at(1)->phi(), mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_lepton1_eta"+sysName]->Fill(m_goodElectron->at(0)->eta(), mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_lepton2_eta"+sysName]->Fill(m_goodElectron->at(1)->eta(), mcEventWeight_Zee);
-                          hMap1D[h_channel+"monojet_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton1_pt, m_histSys, m_electronStore.Pt(0) * 0.001, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton2_pt, m_histSys, m_electronStore.Pt(1) * 0.001, mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton1_phi, m_histSys, m_electronStore.Phi(0), mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton2_phi, m_histSys, m_electronStore.Phi(1), mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton1_eta, m_histSys, m_electronStore.Eta(0), mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_lepton2_eta, m_histSys, m_electronStore.Eta(1), mcEventWeight_Zee, kWeightElectron);
+                          m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                         }
 
                       } // pass dPhijetmet_Zee
@@ -4824,16 +4927,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                     // VBF phasespace //
                     ////////////////////
                     if ( pass_diJet ) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee, VBF]DiJet");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeVBFDiJet);
                       if (sysName == "" && m_useArrayCutflow) m_eventCutflow[35]+=1;
                       if ( mjj > m_mjjCut ) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee, VBF]mjj cut");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeVBFMjjCut);
                         if (sysName == "" && m_useArrayCutflow) m_eventCutflow[36]+=1;
                         if ( pass_CJV ) {
-                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee, VBF]CJV cut");
+                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeVBFCJVCut);
                           if (sysName == "" && m_useArrayCutflow) m_eventCutflow[37]+=1;
                           if ( pass_dPhijetmet_Zee ) {
-                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Zee, VBF]dPhi(jet_i,MET) cut");
+                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutZeeVBFDPhiJetMETCut);
                             if (sysName == "" && m_useArrayCutflow) m_eventCutflow[38]+=1;
 
                             // Calculate electron SF
@@ -4847,60 +4950,61 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                             // Fill histogram
                             // For Ratio plot (Blind MET and Mjj)
                             if (emulMET_Zee < m_METblindcut && mjj < m_Mjjblindcut) {
-                              hMap1D["Zee_MET_search"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                              hMap1D["Zee_Mjj_search"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                              hMap1D["Zee_DeltaPhiAll"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                              m_histRegistry->Fill(kChZee, kRegRatio, kVar_MET_search, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(kChZee, kRegRatio, kVar_Mjj_search, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(kChZee, kRegRatio, kVar_DeltaPhiAll, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                             }
                             // For publication
-                            hMap1D[h_channel+"vbf_met_emulmet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                            hMap1D[h_channel+"vbf_mjj"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                            hMap1D[h_channel+"vbf_dPhijj"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet_cst, m_histSys, emulMET_Zee_CST * 0.001, mcEventWeight_Zee, kWeightElectron);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                             // Average Interaction
-                            hMap1D[h_channel+"vbf_avg_interaction"+sysName]->Fill(m_AverageInteractionsPerCrossing, mcEventWeight_Zee);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_avg_interaction, m_histSys, m_AverageInteractionsPerCrossing, mcEventWeight_Zee, kWeightElectron);
 
                             // For top enhanced control region
                             if (n_bJet > 0) { // At least 1 bJet
-                              hMap1D[h_channel+"vbf_met_emulmet_1bJet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_mjj_1bJet"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_dPhijj_1bJet"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet_1bJet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj_1bJet, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj_1bJet, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                             }
                             if (n_bJet > 1) { // At least 2 bJet
-                              hMap1D[h_channel+"vbf_met_emulmet_2bJet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_mjj_2bJet"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_dPhijj_2bJet"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_met_emulmet_2bJet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mjj_2bJet, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhijj_2bJet, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                             }
 
                             if (sysName == ""){
                               // Jets
-                              hMap1D[h_channel+"vbf_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet1_pt"+sysName]->Fill(jet1_pt * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet2_pt"+sysName]->Fill(jet2_pt * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet1_phi"+sysName]->Fill(jet1_phi, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet2_phi"+sysName]->Fill(jet2_phi, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet1_eta"+sysName]->Fill(jet1_eta, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet2_eta"+sysName]->Fill(jet2_eta, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet1_rap"+sysName]->Fill(jet1_rapidity, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_jet2_rap"+sysName]->Fill(jet2_rapidity, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_dRjj"+sysName]->Fill(deltaR(jet1_eta, jet2_eta, jet1_phi, jet2_phi), mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_dPhimetj1"+sysName]->Fill(dPhiJet1Met_Zee, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_dPhimetj2"+sysName]->Fill(dPhiJet2Met_Zee, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet_Zee, mcEventWeight_Zee);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_pt, m_histSys, jet1_pt * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_pt, m_histSys, jet2_pt * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_phi, m_histSys, jet1_phi, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_phi, m_histSys, jet2_phi, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_eta, m_histSys, jet1_eta, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_eta, m_histSys, jet2_eta, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet1_rap, m_histSys, jet1_rapidity, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet2_rap, m_histSys, jet2_rapidity, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dRjj, m_histSys, dRjj, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj1, m_histSys, dPhiJet1Met_Zee, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj2, m_histSys, dPhiJet2Met_Zee, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet_Zee, mcEventWeight_Zee, kWeightElectron);
                               // For jet3
                               if (m_goodJet->size() > 2){
-                                hMap1D[h_channel+"vbf_jet3_pt"+sysName]->Fill(jet3_pt * 0.001, mcEventWeight_Zee);
-                                hMap1D[h_channel+"vbf_jet3_phi"+sysName]->Fill(jet3_phi, mcEventWeight_Zee);
-                                hMap1D[h_channel+"vbf_jet3_eta"+sysName]->Fill(jet3_eta, mcEventWeight_Zee);
-                                hMap1D[h_channel+"vbf_jet3_rap"+sysName]->Fill(jet3_rapidity, mcEventWeight_Zee);
-                                hMap1D[h_channel+"vbf_dPhimetj3"+sysName]->Fill(dPhiJet3Met_Zee, mcEventWeight_Zee);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_pt, m_histSys, jet3_pt * 0.001, mcEventWeight_Zee, kWeightElectron);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_phi, m_histSys, jet3_phi, mcEventWeight_Zee, kWeightElectron);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_eta, m_histSys, jet3_eta, mcEventWeight_Zee, kWeightElectron);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_jet3_rap, m_histSys, jet3_rapidity, mcEventWeight_Zee, kWeightElectron);
+                                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_dPhimetj3, m_histSys, dPhiJet3Met_Zee, mcEventWeight_Zee, kWeightElectron);
                               }
                               // Leptons
-                              hMap1D[h_channel+"vbf_lepton1_pt"+sysName]->Fill(m_goodElectron->at(0)->pt() * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_lepton2_pt"+sysName]->Fill(m_goodElectron->at(1)->pt() * 0.001, mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_lepton1_phi"+sysName]->Fill(m_goodElectron->at(0)->phi(), mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_lepton2_phi"+sysName]->Fill(m_goodElectron->at(1)->phi(), mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_lepton1_eta"+sysName]->Fill(m_goodElectron->at(0)->eta(), mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_lepton2_eta"+sysName]->Fill(m_goodElectron->at(1)->eta(), mcEventWeight_Zee);
-                              hMap1D[h_channel+"vbf_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton1_pt, m_histSys, m_electronStore.Pt(0) * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton2_pt, m_histSys, m_electronStore.Pt(1) * 0.001, mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton1_phi, m_histSys, m_electronStore.Phi(0), mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton2_phi, m_histSys, m_electronStore.Phi(1), mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton1_eta, m_histSys, m_electronStore.Eta(0), mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_lepton2_eta, m_histSys, m_electronStore.Eta(1), mcEventWeight_Zee, kWeightElectron);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                             }
 
                           } // pass dPhijetmet_Zee
@@ -4959,8 +5063,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                             h_wenu_jet1_rap->Fill(jet1_rapidity, mcEventWeight_Wenu);
                             h_wenu_jet2_rap->Fill(jet2_rapidity, mcEventWeight_Wenu);
                             h_wenu_mjj->Fill(mjj * 0.001, mcEventWeight_Wenu);
-                            h_wenu_dPhijj->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Wenu);
-                            h_wenu_dRjj->Fill(deltaR(jet1_eta, jet2_eta, jet1_phi, jet2_phi), mcEventWeight_Wenu);
+                            h_wenu_dPhijj->Fill(dPhijj, mcEventWeight_Wenu);
+                            h_wenu_dRjj->Fill(dRjj, mcEventWeight_Wenu);
                             h_wenu_dPhimetj1->Fill(dPhiJet1Met_Wenu, mcEventWeight_Wenu);
                             h_wenu_dPhimetj2->Fill(dPhiJet2Met_Wenu, mcEventWeight_Wenu);
                             h_wenu_dPhiMinmetjet->Fill(dPhiMinjetmet_Wenu, mcEventWeight_Wenu);
@@ -4973,9 +5077,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                             h_wenu_dPhimetj3->Fill(dPhiJet3Met_Wenu, mcEventWeight_Wenu);
                             }
                             // Leptons
-                            h_wenu_electron_pt->Fill(m_goodElectron->at(0)->pt() * 0.001, mcEventWeight_Wenu);
-                            h_wenu_electron_phi->Fill(m_goodElectron->at(0)->phi(), mcEventWeight_Wenu);
-                            h_wenu_electron_eta->Fill(m_goodElectron->at(0)->eta(), mcEventWeight_Wenu);
+                            h_wenu_electron_pt->Fill(m_electronStore.Pt(0) * 0.001, mcEventWeight_Wenu);
+                            h_wenu_electron_phi->Fill(m_electronStore.Phi(0), mcEventWeight_Wenu);
+                            h_wenu_electron_eta->Fill(m_electronStore.Eta(0), mcEventWeight_Wenu);
                             h_wenu_mT->Fill(mT_electron * 0.001, mcEventWeight_Wenu);
                             */
 
@@ -5004,7 +5108,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     ////////////////////
 
     if (m_isZmumu && sysName == ""){
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
 
       if ( m_trigDecisionTool->isPassed("HLT_mu20_iloose_L1MU15") || m_trigDecisionTool->isPassed("HLT_mu50") ) { // pass muon trigger to avoid bias
         if ( m_goodMuonForZ->size() > 1 && m_goodElectron->size() == 0 && m_goodTau->size() == 0 ) { // Letopn veto
@@ -5013,64 +5117,64 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               if (pass_diJet && mjj > m_mjjCut && pass_CJV && pass_dPhijetmet_Zmumu) {
                 // Fill histogram
                 // MET Trigger efficiency (for turn-on curve)
-                hMap1D[h_channel+"vbf_eff_study_met_emulmet"+sysName]->Fill(emulMET_Zmumu * 0.001, 1.);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_met_emulmet, m_histSys, emulMET_Zmumu * 0.001, 1., kWeightUnit);
                 if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                  hMap1D[h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70"+sysName]->Fill(emulMET_Zmumu * 0.001, 1.);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70, m_histSys, emulMET_Zmumu * 0.001, 1., kWeightUnit);
                 }
                 if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                  hMap1D[h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70_tclcw"+sysName]->Fill(emulMET_Zmumu * 0.001, 1.);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70_tclcw, m_histSys, emulMET_Zmumu * 0.001, 1., kWeightUnit);
                 }
                 // MET Trigger efficiency for mjj and dPhi(j1,j2)
                 // For all MET
                 if ( emulMET_Zmumu > 0. ) {
-                  hMap1D[h_channel+"vbf_eff_study_mjj_allmet"+sysName]->Fill(mjj * 0.001, 1.);
-                  hMap1D[h_channel+"vbf_eff_study_dPhijj_allmet"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet, m_histSys, dPhijj, 1., kWeightUnit);
                   if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                   if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                 }
                 // MET > 130 GeV
                 if ( emulMET_Zmumu > 130000. ) {
-                  hMap1D[h_channel+"vbf_eff_study_mjj_met130"+sysName]->Fill(mjj * 0.001, 1.);
-                  hMap1D[h_channel+"vbf_eff_study_dPhijj_met130"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met130, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130, m_histSys, dPhijj, 1., kWeightUnit);
                   if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                   if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                 }
                 // MET > 150 GeV
                 if ( emulMET_Zmumu > 150000. ) {
-                  hMap1D[h_channel+"vbf_eff_study_mjj_met150"+sysName]->Fill(mjj * 0.001, 1.);
-                  hMap1D[h_channel+"vbf_eff_study_dPhijj_met150"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met150, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150, m_histSys, dPhijj, 1., kWeightUnit);
                   if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                   if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                 }
                 // MET > 200 GeV
                 if ( emulMET_Zmumu > 200000. ) {
-                  hMap1D[h_channel+"vbf_eff_study_mjj_met200"+sysName]->Fill(mjj * 0.001, 1.);
-                  hMap1D[h_channel+"vbf_eff_study_dPhijj_met200"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met200, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200, m_histSys, dPhijj, 1., kWeightUnit);
                   if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                   if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                    hMap1D[h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                    hMap1D[h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                   }
                 }
 
@@ -5089,7 +5193,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //-----------------------------------------
 
     if (m_isWmunu && sysName == ""){
-      h_channel = "h_wmunu_";
+      m_histChannel = kChWmunu;
 
       if ( m_trigDecisionTool->isPassed("HLT_mu20_iloose_L1MU15") || m_trigDecisionTool->isPassed("HLT_mu50") ) { // pass muon trigger to avoid bias
         if (m_goodElectron->size() == 0) {
@@ -5103,64 +5207,64 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                         if ( pass_CJV ) {
                           // Fill histogram
                           // MET Trigger efficiency (for turn-on curve)
-                          hMap1D[h_channel+"vbf_eff_study_met_emulmet"+sysName]->Fill(emulMET_Zmumu * 0.001, 1.);
+                          m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_met_emulmet, m_histSys, emulMET_Zmumu * 0.001, 1., kWeightUnit);
                           if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                            hMap1D[h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70"+sysName]->Fill(emulMET_Zmumu * 0.001, 1.);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70, m_histSys, emulMET_Zmumu * 0.001, 1., kWeightUnit);
                           }
                           if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                            hMap1D[h_channel+"vbf_eff_study_met_emulmet_pass_HLT_xe70_tclcw"+sysName]->Fill(emulMET_Zmumu * 0.001, 1.);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_met_emulmet_pass_HLT_xe70_tclcw, m_histSys, emulMET_Zmumu * 0.001, 1., kWeightUnit);
                           }
                           // MET Trigger efficiency for mjj and dPhi(j1,j2)
                           // For all MET
                           if ( emulMET_Wmunu > 0. ) {
-                            hMap1D[h_channel+"vbf_eff_study_mjj_allmet"+sysName]->Fill(mjj * 0.001, 1.);
-                            hMap1D[h_channel+"vbf_eff_study_dPhijj_allmet"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet, m_histSys, dPhijj, 1., kWeightUnit);
                             if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                             if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_allmet_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_allmet_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                           }
                           // MET > 130 GeV
                           if ( emulMET_Wmunu > 130000. ) {
-                            hMap1D[h_channel+"vbf_eff_study_mjj_met130"+sysName]->Fill(mjj * 0.001, 1.);
-                            hMap1D[h_channel+"vbf_eff_study_dPhijj_met130"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met130, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130, m_histSys, dPhijj, 1., kWeightUnit);
                             if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                             if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_met130_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met130_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                           }
                           // MET > 150 GeV
                           if ( emulMET_Wmunu > 150000. ) {
-                            hMap1D[h_channel+"vbf_eff_study_mjj_met150"+sysName]->Fill(mjj * 0.001, 1.);
-                            hMap1D[h_channel+"vbf_eff_study_dPhijj_met150"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met150, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150, m_histSys, dPhijj, 1., kWeightUnit);
                             if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                             if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_met150_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met150_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                           }
                           // MET > 200 GeV
                           if ( emulMET_Wmunu > 200000. ) {
-                            hMap1D[h_channel+"vbf_eff_study_mjj_met200"+sysName]->Fill(mjj * 0.001, 1.);
-                            hMap1D[h_channel+"vbf_eff_study_dPhijj_met200"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met200, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                            m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200, m_histSys, dPhijj, 1., kWeightUnit);
                             if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                             if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") ) {
-                              hMap1D[h_channel+"vbf_eff_study_mjj_met200_pass_HLT_xe70_tclcw"+sysName]->Fill(mjj * 0.001, 1.);
-                              hMap1D[h_channel+"vbf_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), 1.);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_mjj_met200_pass_HLT_xe70_tclcw, m_histSys, mjj * 0.001, 1., kWeightUnit);
+                              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw, m_histSys, dPhijj, 1., kWeightUnit);
                             }
                           }
 
@@ -5185,7 +5289,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //-----------------------------------------------------
 
     if (m_isZmumu) {
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
 
       if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
         if ( m_goodMuonForZ->size() > 1 && m_goodElectron->size() == 0 && m_goodTau->size() == 0 ) { // Letopn veto
@@ -5208,22 +5312,22 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
                   // Fill histogram
                   // All charge muon
-                  hMap1D[h_channel+"monojet_multijet_study_mll_all_lep"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_mll_all_lep, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                   if (mll_muon > m_mllMin && mll_muon < m_mllMax){
-                    hMap1D[h_channel+"monojet_multijet_study_met_emulmet_all_lep"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                    m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_all_lep, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                   }
                   // Opposite sign charge muon
                   if ( pass_OSmuon ) {
-                    hMap1D[h_channel+"monojet_multijet_study_mll_os_lep"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                    m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_mll_os_lep, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                     if (mll_muon > m_mllMin && mll_muon < m_mllMax){
-                      hMap1D[h_channel+"monojet_multijet_study_met_emulmet_os_lep"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_os_lep, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                     }
                   }
                   // Same sign charge muon
                   if ( pass_SSmuon ) {
-                    hMap1D[h_channel+"monojet_multijet_study_mll_ss_lep"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                    m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_mll_ss_lep, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                     if (mll_muon > m_mllMin && mll_muon < m_mllMax){
-                      hMap1D[h_channel+"monojet_multijet_study_met_emulmet_ss_lep"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_ss_lep, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                     }
                   }
                 } // monojet cut
@@ -5243,28 +5347,28 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
                   // Fill histogram
                   // All charge muon
-                  hMap1D[h_channel+"vbf_multijet_study_mll_all_lep"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mll_all_lep, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                   if (mll_muon > m_mllMin && mll_muon < m_mllMax){
-                    hMap1D[h_channel+"vbf_multijet_study_met_emulmet_all_lep"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                    hMap1D[h_channel+"vbf_multijet_study_mjj_all_lep"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                    hMap1D[h_channel+"vbf_multijet_study_dPhijj_all_lep"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_all_lep, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mjj_all_lep, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_all_lep, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                   }
                   // Opposite sign charge muon
                   if ( pass_OSmuon ) {
-                    hMap1D[h_channel+"vbf_multijet_study_mll_os_lep"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mll_os_lep, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                     if (mll_muon > m_mllMin && mll_muon < m_mllMax){
-                      hMap1D[h_channel+"vbf_multijet_study_met_emulmet_os_lep"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                      hMap1D[h_channel+"vbf_multijet_study_mjj_os_lep"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                      hMap1D[h_channel+"vbf_multijet_study_dPhijj_os_lep"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_os_lep, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mjj_os_lep, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_os_lep, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                     }
                   }
                   // Same sign charge muon
                   if ( pass_SSmuon ) {
-                    hMap1D[h_channel+"vbf_multijet_study_mll_ss_lep"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mll_ss_lep, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                     if (mll_muon > m_mllMin && mll_muon < m_mllMax){
-                      hMap1D[h_channel+"vbf_multijet_study_met_emulmet_ss_lep"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                      hMap1D[h_channel+"vbf_multijet_study_mjj_ss_lep"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                      hMap1D[h_channel+"vbf_multijet_study_dPhijj_ss_lep"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_ss_lep, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mjj_ss_lep, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_ss_lep, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                     }
                   }
                 } // VBF cut
@@ -5285,7 +5389,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //---------------------------------------------------
 
     if (m_isZee) {
-      h_channel = "h_zee_";
+      m_histChannel = kChZee;
 
       if ( m_goodJet->size() > 0 ) {
         if ((!m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM18VH")) || (m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM20VH")) || m_trigDecisionTool->isPassed("HLT_e60_lhmedium") || m_trigDecisionTool->isPassed("HLT_e120_lhloose")){
@@ -5313,22 +5417,22 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
                   // Fill histogram
                   // All charge electron
-                  hMap1D[h_channel+"monojet_multijet_study_mll_all_lep"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_mll_all_lep, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                   if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                    hMap1D[h_channel+"monojet_multijet_study_met_emulmet_all_lep"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                    m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_all_lep, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                   }
                   // Opposite sign charge electron
                   if ( pass_OSelectron ) {
-                    hMap1D[h_channel+"monojet_multijet_study_mll_os_lep"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                    m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_mll_os_lep, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                     if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                      hMap1D[h_channel+"monojet_multijet_study_met_emulmet_os_lep"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_os_lep, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                     }
                   }
                   // Same sign charge electron
                   if ( pass_SSelectron ) {
-                    hMap1D[h_channel+"monojet_multijet_study_mll_ss_lep"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                    m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_mll_ss_lep, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                     if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                      hMap1D[h_channel+"monojet_multijet_study_met_emulmet_ss_lep"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                      m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_multijet_study_met_emulmet_ss_lep, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                     }
                   }
                 } // monojet cut
@@ -5348,28 +5452,28 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
                   // Fill histogram
                   // All charge electron
-                  hMap1D[h_channel+"vbf_multijet_study_mll_all_lep"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mll_all_lep, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                   if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                    hMap1D[h_channel+"vbf_multijet_study_met_emulmet_all_lep"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                    hMap1D[h_channel+"vbf_multijet_study_mjj_all_lep"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                    hMap1D[h_channel+"vbf_multijet_study_dPhijj_all_lep"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_all_lep, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mjj_all_lep, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_all_lep, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                   }
                   // Opposite sign charge electron
                   if ( pass_OSelectron ) {
-                    hMap1D[h_channel+"vbf_multijet_study_mll_os_lep"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mll_os_lep, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                     if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                      hMap1D[h_channel+"vbf_multijet_study_met_emulmet_os_lep"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                      hMap1D[h_channel+"vbf_multijet_study_mjj_os_lep"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                      hMap1D[h_channel+"vbf_multijet_study_dPhijj_os_lep"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_os_lep, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mjj_os_lep, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_os_lep, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                     }
                   }
                   // Same sign charge electron
                   if ( pass_SSelectron ) {
-                    hMap1D[h_channel+"vbf_multijet_study_mll_ss_lep"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                    m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mll_ss_lep, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
                     if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                      hMap1D[h_channel+"vbf_multijet_study_met_emulmet_ss_lep"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                      hMap1D[h_channel+"vbf_multijet_study_mjj_ss_lep"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                      hMap1D[h_channel+"vbf_multijet_study_dPhijj_ss_lep"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_met_emulmet_ss_lep, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_mjj_ss_lep, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                      m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_multijet_study_dPhijj_ss_lep, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                     }
                   }
 
@@ -5390,7 +5494,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //-----------------------------------------------------
 
     if (m_isZmumu && sysName == "") {
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
 
       //////////////////////
       // Nominal Muon cut //
@@ -5417,19 +5521,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               // Fill histogram
               // 150 < MET < 200 GeV
               if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met150_200_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met150_200_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met200_300_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met200_300_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met300_500_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met300_500_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
               // MET > 500 GeV
               if ( emulMET_Zmumu > 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met500_inf_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met500_inf_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
 
             } // Monojet
@@ -5450,19 +5554,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               // Fill histogram
               // 150 < MET < 200 GeV
               if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met150_200_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met150_200_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met200_300_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met200_300_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met300_500_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met300_500_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
               // MET > 500 GeV
               if ( emulMET_Zmumu > 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met500_inf_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met500_inf_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               }
 
 
@@ -5489,18 +5593,15 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
             baseline_muon1_tp = m_baselineMuon->at(0)->primaryTrackParticle();
             baseline_muon2_tp = m_baselineMuon->at(1)->primaryTrackParticle();
             // d0 significance (Transverse impact parameter)
-            double baseline_muon1_d0sig = xAOD::TrackingHelpers::d0significance( baseline_muon1_tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
-            double baseline_muon2_d0sig = xAOD::TrackingHelpers::d0significance( baseline_muon2_tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
+            double baseline_muon1_d0sig = xAOD::TrackingHelpers::d0significance( baseline_muon1_tp, m_eventContext.beamPosSigmaX, m_eventContext.beamPosSigmaY, m_eventContext.beamPosSigmaXY );
+            double baseline_muon2_d0sig = xAOD::TrackingHelpers::d0significance( baseline_muon2_tp, m_eventContext.beamPosSigmaX, m_eventContext.beamPosSigmaY, m_eventContext.beamPosSigmaXY );
 
             // S-S or O-S charge decision
             float muon_OS = false;
-            if ( m_baselineMuon->at(0)->charge() * m_baselineMuon->at(1)->charge() < 0 ) muon_OS = true;
+            if ( m_baselineMuonStore.Charge(0) * m_baselineMuonStore.Charge(1) < 0 ) muon_OS = true;
 
             // Mll calculation
-            TLorentzVector baselineMuon1 = m_baselineMuon->at(0)->p4();
-            TLorentzVector baselineMuon2 = m_baselineMuon->at(1)->p4();
-            auto Zmass_baselineMuon = baselineMuon1 + baselineMuon2;
-            float mll_baselineMuon = Zmass_baselineMuon.M();
+            float mll_baselineMuon = m_baselineMuonStore.Mass(0, 1);
 
             // Pass or Fail decision for reverse cuts
             // d0 cut
@@ -5554,19 +5655,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               // Fill histogram
               // 150 < MET < 200 GeV
               if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met150_200_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met150_200_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met200_300_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met200_300_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met300_500_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met300_500_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
               // MET > 500 GeV
               if ( emulMET_Zmumu > 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met500_inf_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met500_inf_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
 
               // Fill histogram
@@ -5574,57 +5675,57 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               if ( muon_d0 && !muon_iso && !muon_2lep && !muon_OS ) {
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met150_200_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met150_200_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met200_300_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met200_300_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met300_500_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met300_500_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zmumu > 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met500_inf_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met500_inf_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
               }
               // Case 2
               if ( muon_d0 && !muon_iso && !muon_2lep && muon_OS ) {
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met150_200_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met150_200_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met200_300_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met200_300_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met300_500_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met300_500_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zmumu > 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met500_inf_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met500_inf_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
               }
               // Case 3
               if ( muon_d0 && !muon_iso && muon_2lep && !muon_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met150_200_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met150_200_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met200_300_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met200_300_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met300_500_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met300_500_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zmumu > 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met500_inf_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met500_inf_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
               }
 
@@ -5648,19 +5749,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               // Count reverse cut
               // 150 < MET < 200 GeV
               if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met150_200_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met150_200_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met200_300_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met200_300_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met300_500_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met300_500_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
               // MET > 500 GeV
               if ( emulMET_Zmumu > 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met500_inf_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zmumu);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met500_inf_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zmumu, kWeightMuon);
               }
 
               // Reverse cuts
@@ -5668,57 +5769,57 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               if ( muon_d0 && !muon_iso && !muon_2lep && !muon_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met150_200_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met150_200_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met200_300_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met200_300_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met300_500_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met300_500_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zmumu > 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met500_inf_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met500_inf_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
               }
               // Case 2
               if ( muon_d0 && !muon_iso && !muon_2lep && muon_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met150_200_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met150_200_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met200_300_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met200_300_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met300_500_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met300_500_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zmumu > 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met500_inf_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met500_inf_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
               }
               // Case 3
               if ( muon_d0 && !muon_iso && muon_2lep && !muon_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zmumu > 150000. && emulMET_Zmumu < 200000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met150_200_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met150_200_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zmumu > 200000. && emulMET_Zmumu < 300000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met200_300_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met200_300_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zmumu > 300000. && emulMET_Zmumu < 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met300_500_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met300_500_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zmumu > 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met500_inf_mll"+sysName]->Fill(mll_baselineMuon * 0.001, mcEventWeight_Zmumu);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met500_inf_mll, m_histSys, mll_baselineMuon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                 }
               }
 
@@ -5739,7 +5840,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //---------------------------------------------------
 
     if (m_isZee && sysName == "") {
-      h_channel = "h_zee_";
+      m_histChannel = kChZee;
 
       //////////////////////////
       // Nominal Electron cut //
@@ -5765,22 +5866,22 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
               // Fill histogram
               // MET distribution
-              hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+              m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
               // 150 < MET < 200 GeV
               if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met150_200_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met150_200_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met200_300_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met200_300_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met300_500_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met300_500_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
               // MET > 500 GeV
               if ( emulMET_Zee > 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_nominal_cut_met500_inf_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_nominal_cut_met500_inf_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
 
             } // Monojet
@@ -5801,22 +5902,22 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
               // Fill histogram
               // MET distribution
-              hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+              m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
               // 150 < MET < 200 GeV
               if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met150_200_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met150_200_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met200_300_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met200_300_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met300_500_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met300_500_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
               // MET > 500 GeV
               if ( emulMET_Zee > 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_nominal_cut_met500_inf_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_nominal_cut_met500_inf_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
               }
 
 
@@ -5839,18 +5940,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
             // S-S or O-S charge decision
             float elec_OS = false;
-            if ( m_baselineElectron->at(0)->charge() * m_baselineElectron->at(1)->charge() < 0 ) elec_OS = true;
+            if ( m_baselineElectronStore.Charge(0) * m_baselineElectronStore.Charge(1) < 0 ) elec_OS = true;
 
             // Mll calculation
-            TLorentzVector baselineElectron1 = m_baselineElectron->at(0)->p4();
-            TLorentzVector baselineElectron2 = m_baselineElectron->at(1)->p4();
-            auto Zmass_baselineElectron = baselineElectron1 + baselineElectron2;
-            float mll_baselineElectron = Zmass_baselineElectron.M();
+            float mll_baselineElectron = m_baselineElectronStore.Mass(0, 1);
 
             // Pass or Fail decision for reverse cuts
             // id cut
             bool elec_id = false;
-            if ( m_LHToolLoose2015->accept(*m_baselineElectron->at(0)) && m_LHToolLoose2015->accept(*m_baselineElectron->at(1)) ) elec_id = true;
+            if ( cachedAccept(m_decisionCache, kDecElectronLH, m_LHToolLoose2015, *m_baselineElectron->at(0), m_baselineElectron->at(0)->pt()) &&
+                cachedAccept(m_decisionCache, kDecElectronLH, m_LHToolLoose2015, *m_baselineElectron->at(1), m_baselineElectron->at(1)->pt()) ) elec_id = true;
             // Iso cut
             bool elec_iso = false;
             if ( m_IsoToolVBF->accept(*m_baselineElectron->at(0)) && m_IsoToolVBF->accept(*m_baselineElectron->at(1)) ) elec_iso = true;
@@ -5900,19 +5999,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               // Count reverse cut
               // 150 < MET < 200 GeV
               if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met150_200_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met150_200_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met200_300_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met200_300_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met300_500_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met300_500_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
               // MET > 500 GeV
               if ( emulMET_Zee > 500000.  ) {
-                hMap1D[h_channel+"monojet_qcd_method2_met500_inf_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_met500_inf_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
 
               // Reverse cuts
@@ -5920,57 +6019,57 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               if ( !elec_id && elec_iso && !elec_2lep && !elec_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met150_200_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met150_200_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met200_300_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met200_300_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met300_500_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met300_500_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zee > 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case1_cut_met500_inf_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case1_cut_met500_inf_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
               }
               // Case 2
               if ( !elec_id && !elec_iso && !elec_2lep && elec_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met150_200_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met150_200_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met200_300_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met200_300_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met300_500_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met300_500_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zee > 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case2_cut_met500_inf_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case2_cut_met500_inf_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
               }
               // Case 3
               if ( !elec_id && !elec_iso && !elec_2lep && !elec_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met150_200_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met150_200_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met200_300_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met200_300_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met300_500_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met300_500_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zee > 500000.  ) {
-                  hMap1D[h_channel+"monojet_qcd_method2_case3_cut_met500_inf_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegMonojet, kVar_qcd_method2_case3_cut_met500_inf_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
               }
 
@@ -5993,19 +6092,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               // Count reverse cut
               // 150 < MET < 200 GeV
               if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met150_200_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met150_200_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
               // 200 < MET < 300 GeV
               if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met200_300_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met200_300_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
               // 300 < MET < 500 GeV
               if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met300_500_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met300_500_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
               // MET > 500 GeV
               if ( emulMET_Zee > 500000.  ) {
-                hMap1D[h_channel+"vbf_qcd_method2_met500_inf_count_mll"+sysName]->Fill(count_reverse_cut, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_met500_inf_count_mll, m_histSys, count_reverse_cut, mcEventWeight_Zee, kWeightElectron);
               }
 
               // Reverse cuts
@@ -6013,57 +6112,57 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
               if ( !elec_id && elec_iso && !elec_2lep && !elec_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met150_200_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met150_200_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met200_300_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met200_300_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met300_500_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met300_500_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zee > 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case1_cut_met500_inf_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case1_cut_met500_inf_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
               }
               // Case 2
               if ( !elec_id && !elec_iso && !elec_2lep && elec_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met150_200_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met150_200_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met200_300_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met200_300_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met300_500_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met300_500_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zee > 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case2_cut_met500_inf_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case2_cut_met500_inf_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
               }
               // Case 3
               if ( !elec_id && !elec_iso && !elec_2lep && !elec_OS ) { 
                 // 150 < MET < 200 GeV
                 if ( emulMET_Zee > 150000. && emulMET_Zee < 200000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met150_200_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met150_200_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 200 < MET < 300 GeV
                 if ( emulMET_Zee > 200000. && emulMET_Zee < 300000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met200_300_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met200_300_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // 300 < MET < 500 GeV
                 if ( emulMET_Zee > 300000. && emulMET_Zee < 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met300_500_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met300_500_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
                 // MET > 500 GeV
                 if ( emulMET_Zee > 500000.  ) {
-                  hMap1D[h_channel+"vbf_qcd_method2_case3_cut_met500_inf_mll"+sysName]->Fill(mll_baselineElectron * 0.001, mcEventWeight_Zee);
+                  m_histRegistry->Fill(m_histChannel, kRegVBF, kVar_qcd_method2_case3_cut_met500_inf_mll, m_histSys, mll_baselineElectron * 0.001, mcEventWeight_Zee, kWeightElectron);
                 }
               }
 
@@ -6088,7 +6187,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
     if (m_isZnunu && sysName == "") {
-      h_channel = "h_znunu_";
+      m_histChannel = kChZnunu;
 
       if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") && MET > 150000. ) {
 
@@ -6098,15 +6197,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
             // Fill histogram
             // For publication
-            hMap1D[h_channel+"sm1_met"+sysName]->Fill(MET * 0.001, mcEventWeight);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_met, m_histSys, MET * 0.001, mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_met_cst, m_histSys, MET_CST * 0.001, mcEventWeight, kWeightEvent);
             // Jets
-            hMap1D[h_channel+"sm1_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight);
-            hMap1D[h_channel+"sm1_jet_pt"+sysName]->Fill(sm1jet_pt * 0.001, mcEventWeight);
-            hMap1D[h_channel+"sm1_jet_phi"+sysName]->Fill(sm1jet_phi, mcEventWeight);
-            hMap1D[h_channel+"sm1_jet_eta"+sysName]->Fill(sm1jet_eta, mcEventWeight);
-            hMap1D[h_channel+"sm1_jet_rap"+sysName]->Fill(sm1jet_rapidity, mcEventWeight);
-            hMap1D[h_channel+"sm1_dPhimetjet"+sysName]->Fill(dPhiSM1jetMet, mcEventWeight);
-            hMap1D[h_channel+"sm1_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet, mcEventWeight);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_pt, m_histSys, sm1jet_pt * 0.001, mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_phi, m_histSys, sm1jet_phi, mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_eta, m_histSys, sm1jet_eta, mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_rap, m_histSys, sm1jet_rapidity, mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_dPhimetjet, m_histSys, dPhiSM1jetMet, mcEventWeight, kWeightEvent);
+            m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet, mcEventWeight, kWeightEvent);
 
           } // sm1jet
         } // Veto
@@ -6121,7 +6221,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
     if (m_isZmumu && sysName == "") {
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
 
       if ( m_trigDecisionTool->isPassed("HLT_xe70_tc_lcw") && emulMET_Zmumu > 150000. ) {
 
@@ -6141,23 +6241,24 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
               // Fill histogram
               // For publication
-              hMap1D[h_channel+"sm1_met_emulmet"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_met_emulmet, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_met_emulmet_cst, m_histSys, emulMET_Zmumu_CST * 0.001, mcEventWeight_Zmumu, kWeightMuon);
               // Jets
-              hMap1D[h_channel+"sm1_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_jet_pt"+sysName]->Fill(sm1jet_pt * 0.001, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_jet_phi"+sysName]->Fill(sm1jet_phi, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_jet_eta"+sysName]->Fill(sm1jet_eta, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_jet_rap"+sysName]->Fill(sm1jet_rapidity, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_dPhimetjet"+sysName]->Fill(dPhiSM1jetMet_Zmumu, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet_Zmumu, mcEventWeight_Zmumu);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_pt, m_histSys, sm1jet_pt * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_phi, m_histSys, sm1jet_phi, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_eta, m_histSys, sm1jet_eta, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_rap, m_histSys, sm1jet_rapidity, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_dPhimetjet, m_histSys, dPhiSM1jetMet_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet_Zmumu, mcEventWeight_Zmumu, kWeightMuon);
               // Leptons
-              hMap1D[h_channel+"sm1_lepton1_pt"+sysName]->Fill(m_goodMuonForZ->at(0)->pt() * 0.001, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_lepton2_pt"+sysName]->Fill(m_goodMuonForZ->at(1)->pt() * 0.001, mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_lepton1_phi"+sysName]->Fill(m_goodMuonForZ->at(0)->phi(), mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_lepton2_phi"+sysName]->Fill(m_goodMuonForZ->at(1)->phi(), mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_lepton1_eta"+sysName]->Fill(m_goodMuonForZ->at(0)->eta(), mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_lepton2_eta"+sysName]->Fill(m_goodMuonForZ->at(1)->eta(), mcEventWeight_Zmumu);
-              hMap1D[h_channel+"sm1_mll"+sysName]->Fill(mll_muon * 0.001, mcEventWeight_Zmumu);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton1_pt, m_histSys, m_muonForZStore.Pt(0) * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton2_pt, m_histSys, m_muonForZStore.Pt(1) * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton1_phi, m_histSys, m_muonForZStore.Phi(0), mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton2_phi, m_histSys, m_muonForZStore.Phi(1), mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton1_eta, m_histSys, m_muonForZStore.Eta(0), mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton2_eta, m_histSys, m_muonForZStore.Eta(1), mcEventWeight_Zmumu, kWeightMuon);
+              m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_mll, m_histSys, mll_muon * 0.001, mcEventWeight_Zmumu, kWeightMuon);
 
             } // sm1jet
           } // dimuon
@@ -6173,7 +6274,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //----------------------
 
     if (m_isZee && sysName == "") {
-      h_channel = "h_zee_";
+      m_histChannel = kChZee;
 
       if ((!m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM18VH")) || (m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM20VH")) || m_trigDecisionTool->isPassed("HLT_e60_lhmedium") || m_trigDecisionTool->isPassed("HLT_e120_lhloose")) {
 
@@ -6195,23 +6296,24 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
                 // Fill histogram
                 // For publication
-                hMap1D[h_channel+"sm1_met_emulmet"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_met_emulmet, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_met_emulmet_cst, m_histSys, emulMET_Zee_CST * 0.001, mcEventWeight_Zee, kWeightElectron);
                 // Jets
-                hMap1D[h_channel+"sm1_njet"+sysName]->Fill(m_goodJet->size(), mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_jet_pt"+sysName]->Fill(sm1jet_pt * 0.001, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_jet_phi"+sysName]->Fill(sm1jet_phi, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_jet_eta"+sysName]->Fill(sm1jet_eta, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_jet_rap"+sysName]->Fill(sm1jet_rapidity, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_dPhimetjet"+sysName]->Fill(dPhiSM1jetMet_Zee, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_dPhiMinmetjet"+sysName]->Fill(dPhiMinjetmet_Zee, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_njet, m_histSys, m_goodJet->size(), mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_pt, m_histSys, sm1jet_pt * 0.001, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_phi, m_histSys, sm1jet_phi, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_eta, m_histSys, sm1jet_eta, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_jet_rap, m_histSys, sm1jet_rapidity, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_dPhimetjet, m_histSys, dPhiSM1jetMet_Zee, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_dPhiMinmetjet, m_histSys, dPhiMinjetmet_Zee, mcEventWeight_Zee, kWeightElectron);
                 // Leptons
-                hMap1D[h_channel+"sm1_lepton1_pt"+sysName]->Fill(m_goodElectron->at(0)->pt() * 0.001, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_lepton2_pt"+sysName]->Fill(m_goodElectron->at(1)->pt() * 0.001, mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_lepton1_phi"+sysName]->Fill(m_goodElectron->at(0)->phi(), mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_lepton2_phi"+sysName]->Fill(m_goodElectron->at(1)->phi(), mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_lepton1_eta"+sysName]->Fill(m_goodElectron->at(0)->eta(), mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_lepton2_eta"+sysName]->Fill(m_goodElectron->at(1)->eta(), mcEventWeight_Zee);
-                hMap1D[h_channel+"sm1_mll"+sysName]->Fill(mll_electron * 0.001, mcEventWeight_Zee);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton1_pt, m_histSys, m_electronStore.Pt(0) * 0.001, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton2_pt, m_histSys, m_electronStore.Pt(1) * 0.001, mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton1_phi, m_histSys, m_electronStore.Phi(0), mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton2_phi, m_histSys, m_electronStore.Phi(1), mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton1_eta, m_histSys, m_electronStore.Eta(0), mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_lepton2_eta, m_histSys, m_electronStore.Eta(1), mcEventWeight_Zee, kWeightElectron);
+                m_histRegistry->Fill(m_histChannel, kRegSM1, kVar_mll, m_histSys, mll_electron * 0.001, mcEventWeight_Zee, kWeightElectron);
 
               } // sm1jet
             } // dilepton
@@ -6230,7 +6332,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     if (m_isZmumu && !m_isData && sysName == "") {
 
-      h_channel = "h_zmumu_";
+      m_histChannel = kChZmumu;
 
       //////////////////////////
       // Nominal Truth level //
@@ -6247,8 +6349,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                 if (pass_truth_monoJet && pass_truth_dPhijetmet_Zmumu) {
 
                   // Fill histogram
-                  hMap1D[h_channel+"truth_monojet_met_emulmet"+sysName]->Fill(m_truthEmulMETZmumu * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_monojet_mll"+sysName]->Fill(truth_mll_muon * 0.001, mcEventWeight);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthMonojet, kVar_met_emulmet, m_histSys, m_truthEmulMETZmumu * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthMonojet, kVar_mll, m_histSys, truth_mll_muon * 0.001, mcEventWeight, kWeightEvent);
                 }
 
                 ////////////////////
@@ -6257,10 +6359,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                 if (pass_truth_diJet && truth_mjj > m_mjjCut && pass_truth_CJV && pass_truth_dPhijetmet_Zmumu) {
 
                   // Fill histogram
-                  hMap1D[h_channel+"truth_vbf_met_emulmet"+sysName]->Fill(m_truthEmulMETZmumu * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_mjj"+sysName]->Fill(truth_mjj * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_dPhijj"+sysName]->Fill(deltaPhi(truth_jet1_phi, truth_jet2_phi), mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_mll"+sysName]->Fill(truth_mll_muon * 0.001, mcEventWeight);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_met_emulmet, m_histSys, m_truthEmulMETZmumu * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_mjj, m_histSys, truth_mjj * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_dPhijj, m_histSys, deltaPhi(truth_jet1_phi, truth_jet2_phi), mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_mll, m_histSys, truth_mll_muon * 0.001, mcEventWeight, kWeightEvent);
 
                 }
 
@@ -6285,8 +6387,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                 if (pass_truth_monoJet && pass_truth_dPhijetmet_Zmumu) {
 
                   // Fill histogram
-                  hMap1D[h_channel+"truth_monojet_met_emulmet"+sysName]->Fill(m_truthEmulMETZmumu * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_monojet_mll"+sysName]->Fill(truth_mll_muon * 0.001, mcEventWeight);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthMonojet, kVar_met_emulmet, m_histSys, m_truthEmulMETZmumu * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthMonojet, kVar_mll, m_histSys, truth_mll_muon * 0.001, mcEventWeight, kWeightEvent);
                 }
 
                 ////////////////////
@@ -6295,10 +6397,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                 if (pass_truth_diJet && truth_mjj > m_mjjCut && pass_truth_CJV && pass_truth_dPhijetmet_Zmumu) {
 
                   // Fill histogram
-                  hMap1D[h_channel+"truth_vbf_met_emulmet"+sysName]->Fill(m_truthEmulMETZmumu * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_mjj"+sysName]->Fill(truth_mjj * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_dPhijj"+sysName]->Fill(deltaPhi(truth_jet1_phi, truth_jet2_phi), mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_mll"+sysName]->Fill(truth_mll_muon * 0.001, mcEventWeight);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_met_emulmet, m_histSys, m_truthEmulMETZmumu * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_mjj, m_histSys, truth_mjj * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_dPhijj, m_histSys, deltaPhi(truth_jet1_phi, truth_jet2_phi), mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_mll, m_histSys, truth_mll_muon * 0.001, mcEventWeight, kWeightEvent);
 
                 }
 
@@ -6318,7 +6420,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     if (m_isZee && !m_isData && sysName == "") {
 
-      h_channel = "h_zee_";
+      m_histChannel = kChZee;
       if (m_selectedTruthElectron->size() == 2 || m_selectedTruthMuon->size() == 0 || m_selectedTruthTau->size() == 0) {
         if (pass_truth_OSelectron) {
           if ( pass_truth_dielectronCut ) {
@@ -6331,8 +6433,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                 if (pass_truth_monoJet && pass_truth_dPhijetmet_Zee) {
 
                   // Fill histogram
-                  hMap1D[h_channel+"truth_monojet_met_emulmet"+sysName]->Fill(m_truthEmulMETZee * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_monojet_mll"+sysName]->Fill(truth_mll_electron * 0.001, mcEventWeight);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthMonojet, kVar_met_emulmet, m_histSys, m_truthEmulMETZee * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthMonojet, kVar_mll, m_histSys, truth_mll_electron * 0.001, mcEventWeight, kWeightEvent);
                 }
 
                 ////////////////////
@@ -6341,10 +6443,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                 if (pass_truth_diJet && truth_mjj > m_mjjCut && pass_truth_CJV && pass_truth_dPhijetmet_Zee) {
 
                   // Fill histogram
-                  hMap1D[h_channel+"truth_vbf_met_emulmet"+sysName]->Fill(m_truthEmulMETZee * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_mjj"+sysName]->Fill(truth_mjj * 0.001, mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_dPhijj"+sysName]->Fill(deltaPhi(truth_jet1_phi, truth_jet2_phi), mcEventWeight);
-                  hMap1D[h_channel+"truth_vbf_mll"+sysName]->Fill(truth_mll_electron * 0.001, mcEventWeight);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_met_emulmet, m_histSys, m_truthEmulMETZee * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_mjj, m_histSys, truth_mjj * 0.001, mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_dPhijj, m_histSys, deltaPhi(truth_jet1_phi, truth_jet2_phi), mcEventWeight, kWeightEvent);
+                  m_histRegistry->Fill(m_histChannel, kRegTruthVBF, kVar_mll, m_histSys, truth_mll_electron * 0.001, mcEventWeight, kWeightEvent);
 
                 }
 
@@ -6368,17 +6470,17 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     if (m_isZmumu && m_isEmilyCutflow && sysName == ""){
 
       if ( (m_goodJet->size() > 0 && monojet_pt > 100000.) || (m_goodJet->size() > 1 && jet1_pt > 55000. && jet2_pt > 45000.) ) {
-        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Skim cuts");
+        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuSkimCuts);
         if (m_goodMuonForZ->size() > 1) {
-          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]At least Two Muon");
+          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuAtLeastTwoMuon);
           if (pass_OSmuon) {
-            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Opposite sign charge");
+            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuOppositeSignCharge);
             if (pass_dimuonPtCut) {
-              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Dimuon pT cut");
+              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuDimuonPTCut);
               //if ( m_trigDecisionTool->isPassed("HLT_xe70") ) {
-                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]MET Trigger");
+                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuMETTrigger);
                 if (mll_muon > m_mllMin && mll_muon < m_mllMax) {
-                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Zmass window");
+                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuZmassWindow);
                   /*
                   // MET test
                   if (emulMET_Zmumu < m_metCut) {
@@ -6394,7 +6496,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                   }
                   */
                   if (emulMET_Zmumu > m_metCut) {
-                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]MET cut");
+                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuMETCut);
                     /*
                        if (m_goodTau->size() > 0){
                        Info("execute()", "=====================================");
@@ -6411,16 +6513,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                     }
                     */
                     if (numExtra == 0) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Exact two muon");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuExactTwoMuon);
                       if (m_goodElectron->size() == 0) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Electron veto");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuElectronVeto);
                         if (m_goodTau->size() == 0) {
-                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Tau veto");
+                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuTauVeto);
                           ////////////////////////
                           // MonoJet phasespace //
                           ////////////////////////
                           if (pass_monoJet && pass_dPhijetmet_Zmumu) {
-                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]Monojet cut");
+                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuMonojetCut);
 /*
                             Info("execute()", "================================================");
                             Info("execute()", " Event # = %llu in monojet phasespace", eventInfo->eventNumber());
@@ -6441,13 +6543,13 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                               mcEventWeight_Zmumu = mcEventWeight * totalMuonSF_Zmumu;
                             }
 
-                            hMap1D["Emily_Zmumu_MET_mono"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
+                            m_histRegistry->Fill(kChZmumu, kRegEmily, kVar_MET_mono, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
                           }
                           ////////////////////
                           // VBF phasespace //
                           ////////////////////
                           if (pass_diJet && mjj > m_mjjCut && pass_CJV && pass_dPhijetmet_Zmumu) {
-                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zmumu]VBF cut");
+                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZmumuVBFCut);
 /*
                             Info("execute()", "================================================");
                             Info("execute()", " Event # = %llu in VBF phasespace", eventInfo->eventNumber());
@@ -6468,9 +6570,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                               mcEventWeight_Zmumu = mcEventWeight * totalMuonSF_Zmumu;
                             }
 
-                            hMap1D["Emily_Zmumu_MET_search"+sysName]->Fill(emulMET_Zmumu * 0.001, mcEventWeight_Zmumu);
-                            hMap1D["Emily_Zmumu_Mjj_search"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zmumu);
-                            hMap1D["Emily_Zmumu_DeltaPhiAll"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zmumu);
+                            m_histRegistry->Fill(kChZmumu, kRegEmily, kVar_MET_search, m_histSys, emulMET_Zmumu * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                            m_histRegistry->Fill(kChZmumu, kRegEmily, kVar_Mjj_search, m_histSys, mjj * 0.001, mcEventWeight_Zmumu, kWeightMuon);
+                            m_histRegistry->Fill(kChZmumu, kRegEmily, kVar_DeltaPhiAll, m_histSys, dPhijj, mcEventWeight_Zmumu, kWeightMuon);
                           }
                         } // Tau veto
                       } // Electron veto
@@ -6496,9 +6598,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     if (m_isZee && m_isEmilyCutflow && sysName == ""){
 
       if ( (m_goodJet->size() > 0 && monojet_pt > 100000.) || (m_goodJet->size() > 1 && jet1_pt > 55000. && jet2_pt > 45000.) ) {
-        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Skim cuts");
+        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeSkimCuts);
         if (m_goodElectron->size() > 1) {
-          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]At least Two Electron");
+          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeAtLeastTwoElectron);
              /*
              Info("execute()", "=====================================");
              Info("execute()", " Event # = %llu", eventInfo->eventNumber());
@@ -6512,27 +6614,27 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
              }
              */
           if (pass_OSelectron) {
-            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Opposite sign charge");
+            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeOppositeSignCharge);
             if (pass_dielectronPtCut) {
-              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Dielectron pT cut");
+              if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeDielectronPTCut);
               if ((!m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM18VH")) || (m_isData && m_trigDecisionTool->isPassed("HLT_e24_lhmedium_L1EM20VH")) || m_trigDecisionTool->isPassed("HLT_e60_lhmedium") || m_trigDecisionTool->isPassed("HLT_e120_lhloose")){
-                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Electron Trigger");
+                if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeElectronTrigger);
                 if (mll_electron > m_mllMin && mll_electron < m_mllMax) {
-                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Zmass window");
+                  if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeZmassWindow);
                   //Info("execute()", "  # Electron = %llu, # Muon = %llu, # Tau = %llu", m_goodElectron->size(), m_goodMuon->size(), m_goodTau->size());
                   if (emulMET_Zee > m_metCut) {
-                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]MET cut");
+                    if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeMETCut);
                     if (m_goodMuon->size() == 0) {
-                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Muon veto");
+                      if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeMuonVeto);
                       if (m_goodElectron->size() == 2) {
-                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Exact two electrons");
+                        if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeExactTwoElectrons);
                         if (m_goodTau->size() == 0) {
-                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Tau veto");
+                          if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeTauVeto);
                           ////////////////////////
                           // MonoJet phasespace //
                           ////////////////////////
                           if (pass_monoJet && pass_dPhijetmet_Zee) {
-                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]Monojet cut");
+                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeMonojetCut);
 /*
                             Info("execute()", "================================================");
                             Info("execute()", " Event # = %llu in monojet phasespace", eventInfo->eventNumber());
@@ -6553,13 +6655,13 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                               mcEventWeight_Zee = mcEventWeight * totalElectronSF_Zee;
                             }
 
-                            hMap1D["Emily_Zee_MET_mono"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
+                            m_histRegistry->Fill(kChZee, kRegEmily, kVar_MET_mono, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
                           }
                           ////////////////////
                           // VBF phasespace //
                           ////////////////////
                           if (pass_diJet && mjj > m_mjjCut && pass_CJV && pass_dPhijetmet_Zee) {
-                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->FillCutflow("[Emily, Zee]VBF cut");
+                            if (sysName == "" && m_useBitsetCutflow) m_BitsetCutflow->Fill(kCutEmilyZeeVBFCut);
 /*
                             Info("execute()", "================================================");
                             Info("execute()", " Event # = %llu in VBF phasespace", eventInfo->eventNumber());
@@ -6580,9 +6682,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
                               mcEventWeight_Zee = mcEventWeight * totalElectronSF_Zee;
                             }
 
-                            hMap1D["Emily_Zee_MET_search"+sysName]->Fill(emulMET_Zee * 0.001, mcEventWeight_Zee);
-                            hMap1D["Emily_Zee_Mjj_search"+sysName]->Fill(mjj * 0.001, mcEventWeight_Zee);
-                            hMap1D["Emily_Zee_DeltaPhiAll"+sysName]->Fill(deltaPhi(jet1_phi, jet2_phi), mcEventWeight_Zee);
+                            m_histRegistry->Fill(kChZee, kRegEmily, kVar_MET_search, m_histSys, emulMET_Zee * 0.001, mcEventWeight_Zee, kWeightElectron);
+                            m_histRegistry->Fill(kChZee, kRegEmily, kVar_Mjj_search, m_histSys, mjj * 0.001, mcEventWeight_Zee, kWeightElectron);
+                            m_histRegistry->Fill(kChZee, kRegEmily, kVar_DeltaPhiAll, m_histSys, dPhijj, mcEventWeight_Zee, kWeightElectron);
                           }
                         } // Tau veto
                       } // Exact two electrons
@@ -6598,60 +6700,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     } // end Cutflow
 
 
-
-    //////////////////////////////////
-    // Delete shallow copy containers
-    //////////////////////////////////
-
-    // The containers created by the shallow copy are owned by you. Remember to delete them
-
-    delete muons_shallowCopy.first;
-    delete muons_shallowCopy.second;
-
-    delete elec_shallowCopy.first;
-    delete elec_shallowCopy.second;
-
-    delete phot_shallowCopy.first;
-    delete phot_shallowCopy.second;
-
-    delete tau_shallowCopy.first;
-    delete tau_shallowCopy.second;
-
-    delete jet_shallowCopy.first;
-    delete jet_shallowCopy.second;
+    // Validation of the systematics envelope: a skipped pass must not fill anything
+    if (envelopeSkip && m_histRegistry->NumFills() != numFillsBefore) {
+      m_numEnvelopeFailures++;
+      Warning("execute()", "Systematics envelope rejected event %llu, which passes a region for %s",
+          eventInfo->eventNumber(), sysName.c_str());
+    }
 
 
 
   } // end for loop over systematics
 
-
-
-  //////////////////////////
-  // Delete copy containers
-  //////////////////////////
-
-  // Deep copies. Clearing containers deletes contents including AuxStore.
-  delete m_goodJet;
-
-  // VBF study
-  delete m_goodMuonForZ;
-  delete m_goodMuon;
-  delete m_baselineMuon;
-  delete m_goodElectron;
-  delete m_baselineElectron;
-  delete m_goodTau;
-  delete m_goodPhoton;
-
-  delete m_met;
-  delete m_metAux;
-
-  // Truth containers
-  delete m_selectedTruthNeutrino;
-  delete m_selectedTruthMuon;
-  delete m_selectedTruthElectron;
-  delete m_selectedTruthTau;
-  delete m_selectedTruthJet;
-  //delete m_selectedTruthWZJet;
+  // The nominal and calibrated shallow copies and the containers are freed
+  // (or cleared for reuse) by the arena reset of the next event
 
 
   return EL::StatusCode::SUCCESS;
@@ -6682,7 +6743,30 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // gets called on worker nodes that processed input events.
 
     // cutflow
-    if (m_useBitsetCutflow) m_BitsetCutflow->PushBitSet();;
+    if (m_useBitsetCutflow) {
+      m_BitsetCutflow->PushBitSet();
+      m_BitsetCutflow->Flush();
+    }
+
+    if (!m_isData)
+      Info("finalize()", "Systematics tool reconfigurations: %lld of %lld", m_numToolSwitches, m_numToolSwitchesAll);
+    if (m_doSysEnvelope)
+      Info("finalize()", "Systematics envelope: %lld passes skipped%s, %lld wrongly", m_numEnvelopeSkipped,
+          m_validateSysEnvelope ? " (validated)" : "", m_numEnvelopeFailures);
+    for (unsigned int d = 0; d < kNumObjectDecisions; d++)
+      Info("finalize()", "Object decision cache %s: %lld reused, %lld computed", DecisionCache::Name(d),
+          m_decisionCache->NumHits(d), m_decisionCache->NumMisses(d));
+    if (m_validateEmulatedMET)
+      Info("finalize()", "Emulated MET validation: %lld hypotheses compared with their rebuild, %lld differ",
+          m_numEmulMETCompared, m_numEmulMETMismatches);
+    if (m_eventArena->NumEvents() > 0)
+      Info("finalize()", "Event arena: %.1f allocations per event (max %lld), %lld containers reused",
+          double(m_eventArena->TotalAllocations()) / m_eventArena->NumEvents(),
+          m_eventArena->MaxAllocations(), m_eventArena->NumReuses());
+    m_muonCuts->Report();
+    m_elecCuts->Report();
+    m_photCuts->Report();
+    m_tauCuts->Report();
 
     //*************************
     // deleting of all tools
@@ -6971,6 +7055,54 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       m_BitsetCutflow = 0;
     }
 
+    /// Histogram registry
+    if(m_histRegistry){
+      delete m_histRegistry;
+      m_histRegistry = 0;
+    }
+
+    /// Isolated track grid
+    if(m_isoTrackGrid){
+      delete m_isoTrackGrid;
+      m_isoTrackGrid = 0;
+    }
+
+    /// Event arena
+    if(m_eventArena){
+      delete m_eventArena;
+      m_eventArena = 0;
+    }
+
+    /// Object cut chains
+    if(m_muonCuts){
+      delete m_muonCuts;
+      m_muonCuts = 0;
+    }
+    if(m_elecCuts){
+      delete m_elecCuts;
+      m_elecCuts = 0;
+    }
+    if(m_photCuts){
+      delete m_photCuts;
+      m_photCuts = 0;
+    }
+    if(m_tauCuts){
+      delete m_tauCuts;
+      m_tauCuts = 0;
+    }
+
+    /// Object decision cache
+    if(m_decisionCache){
+      delete m_decisionCache;
+      m_decisionCache = 0;
+    }
+
+    /// Jet topology
+    if(m_jetTopology){
+      delete m_jetTopology;
+      m_jetTopology = 0;
+    }
+
 /*
     // print out the number of Overlap removal
     Info("finalize()", "======================================================");
@@ -7035,41 +7167,37 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
 
-  EL::StatusCode ZinvxAODAnalysis :: addHist(std::map<std::string, TH1*> &hMap, std::string tag,
+  EL::StatusCode ZinvxAODAnalysis :: addHist(std::map<std::string, TH1*> &hMap,
+      int channel, int region, int variable, const std::string &sysName,
       int bins, double min, double max) {
 
-    std::string label = tag;
+    std::string label = HistRegistry::Name(channel, region, variable, sysName);
     TH1* h_temp = new TH1F(label.c_str(), "", bins, min, max);
     wk()->addOutput (h_temp);
     hMap[label] = h_temp;
+    m_histRegistry->Register(channel, region, variable, m_histRegistry->AddSystematic(sysName), h_temp);
 
     return EL::StatusCode::SUCCESS;
   }
 
-  EL::StatusCode ZinvxAODAnalysis :: addHist(std::map<std::string, TH1*> &hMap, std::string tag,
+  EL::StatusCode ZinvxAODAnalysis :: addHist(std::map<std::string, TH1*> &hMap,
+      int channel, int region, int variable, const std::string &sysName,
       int bins, Float_t binArray[]) {
 
-    std::string label = tag;
+    std::string label = HistRegistry::Name(channel, region, variable, sysName);
     TH1* h_temp = new TH1F(label.c_str(), "", bins, binArray);
     wk()->addOutput (h_temp);
     hMap[label] = h_temp;
+    m_histRegistry->Register(channel, region, variable, m_histRegistry->AddSystematic(sysName), h_temp);
 
     return EL::StatusCode::SUCCESS;
   }
 
 
   EL::StatusCode ZinvxAODAnalysis :: passMuonSelection(xAOD::Muon& mu,
-      const xAOD::EventInfo* eventInfo, const xAOD::Vertex* primVertex){
-
-    dec_baseline(mu) = false;
-    selectDec(mu) = false; // To select objects for Overlap removal
-    dec_signal(mu) = false;
+      const EventContext& ctx){
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passMuonSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
+    m_muonFlags->Clear(mu.index());
 
     // don't bother calibrating or computing WP
     double muPt = (mu.pt()) * 0.001; /// GeV
@@ -7101,8 +7229,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
     // Baseline Muon
-    dec_baseline(mu) = true;
-    selectDec(mu) = true; // To select objects for Overlap removal
+    m_muonFlags->Set(kObjBaseline, mu.index());
+    m_muonFlags->Set(kObjSelected, mu.index()); // To select objects for Overlap removal
 
 
     // Muon pt cut
@@ -7117,19 +7245,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       tp = mu.trackParticle(xAOD::Muon::ExtrapolatedMuonSpectrometerTrackParticle);
     else
       tp = mu.primaryTrackParticle();
-    double d0sig = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
+    double d0sig = xAOD::TrackingHelpers::d0significance( tp, ctx.beamPosSigmaX, ctx.beamPosSigmaY, ctx.beamPosSigmaXY );
     if (std::abs(d0sig) > 3.0) return EL::StatusCode::SUCCESS;
     // zo cut
     float z0sintheta = 1e8;
     //if (primVertex) z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( mu.p4().Theta() );
-    z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( tp->theta() );
+    z0sintheta = ( tp->z0() + tp->vz() - ctx.primVertexZ ) * TMath::Sin( tp->theta() );
     if (std::abs(z0sintheta) > 0.5) return EL::StatusCode::SUCCESS;
 
     // Isolation requirement
     if (!m_IsolationSelectionTool->accept(mu)) return EL::StatusCode::SUCCESS;
 
     // Signal Muon
-    dec_signal(mu) = true;
+    m_muonFlags->Set(kObjSignal, mu.index());
 
     return EL::StatusCode::SUCCESS;
 
@@ -7140,18 +7268,9 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passMuonVBF(xAOD::Muon& mu,
-      const xAOD::EventInfo* eventInfo, const xAOD::Vertex* primVertex){
+      const EventContext& ctx){
 
-    dec_baseline(mu) = false;
-    dec_signal(mu) = false; // For m_goodMuon container
-    dec_signal_forZ(mu) = false; // For m_goodMuonForZ container where muons are the non-isolated
-    selectDec(mu) = false; // To select objects for Overlap removal
-
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passMuonSignal. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
+    m_muonFlags->Clear(mu.index());
 
     // don't bother calibrating or computing WP
     //if ( mu.pt() < 4000. ) return EL::StatusCode::SUCCESS;
@@ -7168,17 +7287,6 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       }
     }
 
-    // Muon tranverse momentum
-    if (mu.pt() < m_muonPtCut ) return EL::StatusCode::SUCCESS;
-
-    /* // eta cut is included in MuonSelectionTool
-    // Muon eta cut
-    if (std::abs(mu.eta()) > m_lepEtaCut) return EL::StatusCode::SUCCESS;
-    */
-
-    // MuonSelectionTool (Loose)
-    if(!m_loosemuonSelection->accept(mu)) return EL::StatusCode::SUCCESS;
-
     // d0 / z0 cuts applied
     const xAOD::TrackParticle* tp;
     //if (mu.muonType() == xAOD::Muon::SiliconAssociatedForwardMuon)
@@ -7186,29 +7294,46 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //else
     tp = mu.primaryTrackParticle();
 
-    // zo cut
-    //float z0sintheta = 1e8;
-    //if (primVertex) z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( mu.p4().Theta() );
-    float z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( tp->theta() );
-    if (std::fabs(z0sintheta) > 0.5) return EL::StatusCode::SUCCESS;
+    /* // eta cut is included in MuonSelectionTool
+    // Muon eta cut
+    if (std::abs(mu.eta()) > m_lepEtaCut) return EL::StatusCode::SUCCESS;
+    */
+
+    // Baseline cuts (in the order of m_muonCuts)
+    bool passBaseline = m_muonCuts->PassStage(kMuonStageBaseline, [&](unsigned int cut) -> bool {
+      switch (cut) {
+        // Muon tranverse momentum
+        case kMuonCutPt: return mu.pt() >= m_muonPtCut;
+        // MuonSelectionTool (Loose)
+        case kMuonCutLoose: return cachedAccept(m_decisionCache, kDecMuonLoose, m_loosemuonSelection, mu, mu.pt());
+        // zo cut
+        case kMuonCutZ0: return std::fabs(( tp->z0() + tp->vz() - ctx.primVertexZ ) * TMath::Sin( tp->theta() )) <= 0.5;
+      }
+      return true;
+    });
+    if (!passBaseline) return EL::StatusCode::SUCCESS;
 
-    dec_baseline(mu) = true; // For reverse cut for QCD background study (Fail d0 cut, Fail Iso)
+    m_muonFlags->Set(kObjBaseline, mu.index()); // For reverse cut for QCD background study (Fail d0 cut, Fail Iso)
 
     // d0 significance (Transverse impact parameter)
-    double d0sig = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
-    if (std::abs(d0sig) > 3.0) return EL::StatusCode::SUCCESS;
+    bool passForZ = m_muonCuts->PassStage(kMuonStageForZ, [&](unsigned int) -> bool {
+      double d0sig = xAOD::TrackingHelpers::d0significance( tp, ctx.beamPosSigmaX, ctx.beamPosSigmaY, ctx.beamPosSigmaXY );
+      return std::abs(d0sig) <= 3.0;
+    });
+    if (!passForZ) return EL::StatusCode::SUCCESS;
 
 
-    dec_signal_forZ(mu) = true; // For m_goodMuonForZ container where muons are the non-isolated
+    m_muonFlags->Set(kObjSignalForZ, mu.index()); // For m_goodMuonForZ container where muons are the non-isolated
 
     // Isolation requirement
-    if (!m_IsoToolVBF->accept(mu)) return EL::StatusCode::SUCCESS;
+    bool passIso = m_muonCuts->PassStage(kMuonStageSignal, [&](unsigned int) -> bool { return m_IsoToolVBF->accept(mu); });
+    if (!passIso) return EL::StatusCode::SUCCESS;
     // Isolation for specific muon pT range
     //m_isoPtCut = true; if (mu.pt() > m_isoMuonPtMin && mu.pt() < m_isoMuonPtMax && !m_IsoToolVBF->accept(mu)) return EL::StatusCode::SUCCESS;
 
 
-    dec_signal(mu) = true; // For m_goodMuon container
-    selectDec(mu) = true; // To select objects for Overlap removal
+    m_muonFlags->Set(kObjSignal, mu.index()); // For m_goodMuon container
+    m_muonFlags->Set(kObjSelected, mu.index()); // To select objects for Overlap removal
 
     return EL::StatusCode::SUCCESS;
 
@@ -7218,20 +7343,12 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passElectronSelection(xAOD::Electron& elec,
-      const xAOD::EventInfo* eventInfo, const xAOD::Vertex* primVertex){
+      const EventContext& ctx){
 
-    dec_baseline(elec) = false;
-    selectDec(elec) = false; // To select objects for Overlap removal
-    dec_signal(elec) = false;
+    m_elecFlags->Clear(elec.index());
 
     // According to https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2#Electron_identification
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passElectronSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
-
     // don't bother calibrating or computing WP
     double elecPt = (elec.pt()) * 0.001; /// GeV
     //if ( elecPt < 4. ) return EL::StatusCode::SUCCESS;
@@ -7269,8 +7386,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     if (elecPt <= elecPtCut) return EL::StatusCode::SUCCESS; /// veto electron
 
     // Baseline Electron
-    dec_baseline(elec) = true;
-    selectDec(elec) = true; // To select objects for Overlap removal
+    m_elecFlags->Set(kObjBaseline, elec.index());
+    m_elecFlags->Set(kObjSelected, elec.index()); // To select objects for Overlap removal
 
 
     // pT cut
@@ -7280,19 +7397,19 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2#Electron_d0_and_z0_cut_definitio
     // d0 significance (Transverse impact parameter)
     const xAOD::TrackParticle *tp = elec.trackParticle() ; //your input track particle from the electron
-    double d0sig = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
+    double d0sig = xAOD::TrackingHelpers::d0significance( tp, ctx.beamPosSigmaX, ctx.beamPosSigmaY, ctx.beamPosSigmaXY );
     if (std::abs(d0sig) > 5.0) return EL::StatusCode::SUCCESS;
     // zo cut
     float z0sintheta = 1e8;
     //if (primVertex) z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( elec.p4().Theta() );
-    z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( tp->theta() );
+    z0sintheta = ( tp->z0() + tp->vz() - ctx.primVertexZ ) * TMath::Sin( tp->theta() );
     if (std::abs(z0sintheta) > 0.5) return EL::StatusCode::SUCCESS;
 
     // Isolation requirement
     if (!m_IsolationSelectionTool->accept(elec)) return EL::StatusCode::SUCCESS;
 
     // Signal Electron
-    dec_signal(elec) = true;
+    m_elecFlags->Set(kObjSignal, elec.index());
 
     return EL::StatusCode::SUCCESS;
 
@@ -7302,19 +7419,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passElectronVBF(xAOD::Electron& elec,
-      const xAOD::EventInfo* eventInfo,
-      const xAOD::Vertex* primVertex){
-
-    dec_baseline(elec) = false;
-    dec_signal(elec) = false; // For m_goodElectron container
-    selectDec(elec) = false; // To select objects for Overlap removal
+      const EventContext& ctx){
 
+    m_elecFlags->Clear(elec.index());
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passElectronSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
 
     // don't bother calibrating or computing WP
     //if ( elec.pt() < 4000. ) return EL::StatusCode::SUCCESS;
@@ -7327,35 +7435,51 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       Error("execute()", "EgammaCalibrationAndSmearingTool returns Error CorrectionCode");
     }
 
-    // Eta cut
-    //double Eta = elec.caloCluster()->eta();
-    double Eta = elec.caloCluster()->etaBE(2);
-    if ( std::abs(Eta) > m_elecEtaCut || (std::abs(Eta) > 1.37 && std::abs(Eta) < 1.52)) return EL::StatusCode::SUCCESS;
-    //if ( std::abs(Eta) > m_elecEtaCut ) return EL::StatusCode::SUCCESS;
-
-    /// pT cut
-    if (elec.pt() < m_elecPtCut ) return EL::StatusCode::SUCCESS; /// veto electron
-
-    // goodOQ(object quality cut) : Bad Electron Cluster
-    // https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/EGammaIdentificationRun2#Object_quality_cut
-    if( !elec.isGoodOQ(xAOD::EgammaParameters::BADCLUSELECTRON) ) return EL::StatusCode::SUCCESS;
-
     // d0 / z0 cuts applied
     // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2#Electron_d0_and_z0_cut_definitio
-    // d0 significance (Transverse impact parameter)
     const xAOD::TrackParticle *tp = elec.trackParticle() ; //your input track particle from the electron
-    double d0sig = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
-    if (std::abs(d0sig) > 5.0) return EL::StatusCode::SUCCESS;
-    // zo cut
-    float z0sintheta = ( tp->z0() + tp->vz() - primVertex->z() ) * TMath::Sin( tp->theta() );
-    if (std::fabs(z0sintheta) > 0.5) return EL::StatusCode::SUCCESS;
 
-    dec_baseline(elec) = true;
+    // Baseline cuts (in the order of m_elecCuts)
+    bool passBaseline = m_elecCuts->PassStage(kElecStageBaseline, [&](unsigned int cut) -> bool {
+      switch (cut) {
+        // Eta cut
+        case kElecCutEta: {
+          double Eta = elec.caloCluster()->etaBE(2);
+          return !( std::abs(Eta) > m_elecEtaCut || (std::abs(Eta) > 1.37 && std::abs(Eta) < 1.52));
+        }
+        /// pT cut
+        case kElecCutPt: return elec.pt() >= m_elecPtCut; /// veto electron
+        // goodOQ(object quality cut) : Bad Electron Cluster
+        // https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/EGammaIdentificationRun2#Object_quality_cut
+        case kElecCutOQ: {
+          int goodOQ = m_decisionCache->Get(kDecElectronOQ, elec.index(), 0.);
+          if (goodOQ < 0) {
+            goodOQ = elec.isGoodOQ(xAOD::EgammaParameters::BADCLUSELECTRON);
+            m_decisionCache->Set(kDecElectronOQ, elec.index(), 0., goodOQ);
+          }
+          return goodOQ;
+        }
+        // d0 significance (Transverse impact parameter)
+        case kElecCutD0Sig: {
+          double d0sig = xAOD::TrackingHelpers::d0significance( tp, ctx.beamPosSigmaX, ctx.beamPosSigmaY, ctx.beamPosSigmaXY );
+          return std::abs(d0sig) <= 5.0;
+        }
+        // zo cut
+        case kElecCutZ0: return std::fabs(( tp->z0() + tp->vz() - ctx.primVertexZ ) * TMath::Sin( tp->theta() )) <= 0.5;
+      }
+      return true;
+    });
+    if (!passBaseline) return EL::StatusCode::SUCCESS;
+
+    m_elecFlags->Set(kObjBaseline, elec.index());
 
     // LH Electron identification
     //
     // LH Electron (Loose)
-    if (!m_LHToolLoose2015->accept(elec)) return EL::StatusCode::SUCCESS;
+    bool passID = m_elecCuts->PassStage(kElecStageID, [&](unsigned int) -> bool {
+      return cachedAccept(m_decisionCache, kDecElectronLH, m_LHToolLoose2015, elec, elec.pt());
+    });
+    if (!passID) return EL::StatusCode::SUCCESS;
     /*
     // LH Electron (Medium)
     bool LHmediumSel = false;
@@ -7373,10 +7497,11 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     }
 
     // Isolation requirement
-    if (!m_IsoToolVBF->accept(elec)) return EL::StatusCode::SUCCESS;
+    bool passIso = m_elecCuts->PassStage(kElecStageSignal, [&](unsigned int) -> bool { return m_IsoToolVBF->accept(elec); });
+    if (!passIso) return EL::StatusCode::SUCCESS;
 
-    dec_signal(elec) = true; // For m_goodElectron container
-    selectDec(elec) = true; // To select objects for Overlap removal
+    m_elecFlags->Set(kObjSignal, elec.index()); // For m_goodElectron container
+    m_elecFlags->Set(kObjSelected, elec.index()); // To select objects for Overlap removal
 
     return EL::StatusCode::SUCCESS;
 
@@ -7387,19 +7512,12 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passPhotonSelection(xAOD::Photon& phot,
-      const xAOD::EventInfo* eventInfo){
+      const EventContext& ctx){
 
-    dec_baseline(phot) = false;
-    selectDec(phot) = false; // To select objects for Overlap removal
+    m_photFlags->Clear(phot.index());
 
     // According to https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passPhotonSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
-
     // Photon author cuts
     if ( !(phot.author() & (xAOD::EgammaParameters::AuthorPhoton + xAOD::EgammaParameters::AuthorAmbiguous)) )
       return EL::StatusCode::SUCCESS;
@@ -7442,8 +7560,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //if (!m_IsolationSelectionTool->accept(phot)) return EL::StatusCode::SUCCESS;
 
 
-    dec_baseline(phot) = true;
-    selectDec(phot) = true; // To select objects for Overlap removal
+    m_photFlags->Set(kObjBaseline, phot.index());
+    m_photFlags->Set(kObjSelected, phot.index()); // To select objects for Overlap removal
 
     return EL::StatusCode::SUCCESS;
 
@@ -7453,21 +7571,13 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passPhotonVBF(xAOD::Photon& phot,
-      const xAOD::EventInfo* eventInfo){
+      const EventContext& ctx){
 
-    dec_baseline(phot) = false;
-    dec_signal(phot) = false; // For m_goodPhoton container
-    selectDec(phot) = false; // To select objects for Overlap removal
+    m_photFlags->Clear(phot.index());
 
 
     // According to https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passPhotonSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
-
     // Photon author cuts
     //if ( !(phot.author() & (xAOD::EgammaParameters::AuthorPhoton + xAOD::EgammaParameters::AuthorAmbiguous)) )
     uint16_t author =  phot.author();
@@ -7488,32 +7598,39 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       Error("execute()", "EgammaCalibrationAndSmearingTool returns Error CorrectionCode");
     }
 
-    // Eta cut
-    //double Eta = phot.caloCluster()->eta();
-    double Eta = phot.caloCluster()->etaBE(2);
-    //if ( std::abs(Eta) >= m_photEtaCut || (std::abs(Eta) >= 1.37 && std::abs(Eta) <= 1.52)) return EL::StatusCode::SUCCESS;
-    if ( std::abs(Eta) > m_photEtaCut ) return EL::StatusCode::SUCCESS;
-
-    // pT cut
-    if (phot.pt() < m_photPtCut) return EL::StatusCode::SUCCESS; /// veto photon
+    // Baseline cuts (in the order of m_photCuts)
+    bool passBaseline = m_photCuts->PassStage(kPhotStageBaseline, [&](unsigned int cut) -> bool {
+      switch (cut) {
+        // Eta cut
+        case kPhotCutEta: return std::abs(phot.caloCluster()->etaBE(2)) <= m_photEtaCut;
+        // pT cut
+        case kPhotCutPt: return phot.pt() >= m_photPtCut; /// veto photon
+        // goodOQ(object quality cut) : Bad photon Cluster
+        // https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/EGammaIdentificationRun2#Object_quality_cut
+        case kPhotCutOQ: return phot.isGoodOQ(xAOD::EgammaParameters::BADCLUSPHOTON);
+      }
+      return true;
+    });
+    if (!passBaseline) return EL::StatusCode::SUCCESS;
     //Info("execute()", "  Selected photon pt from new Photon Container = %.2f GeV", (phot.pt() * 0.001));
 
-    // goodOQ(object quality cut) : Bad photon Cluster
-    // https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/EGammaIdentificationRun2#Object_quality_cut
-    if( !phot.isGoodOQ(xAOD::EgammaParameters::BADCLUSPHOTON) ) return EL::StatusCode::SUCCESS;
-
-    dec_baseline(phot) = true;
+    m_photFlags->Set(kObjBaseline, phot.index());
 
-    // Recomputing the photon ID flags
-    if (!m_photonTightIsEMSelector->accept(phot)) return EL::StatusCode::SUCCESS;
-    //if (!m_photonLooseIsEMSelector->accept(phot)) return EL::StatusCode::SUCCESS;
-
-    // Isolation requirement
-    if (!m_IsoToolVBF->accept(phot)) return EL::StatusCode::SUCCESS;
+    // Identification and isolation (in the order of m_photCuts)
+    bool passSignal = m_photCuts->PassStage(kPhotStageSignal, [&](unsigned int cut) -> bool {
+      switch (cut) {
+        // Recomputing the photon ID flags
+        case kPhotCutTight: return m_photonTightIsEMSelector->accept(phot);
+        // Isolation requirement
+        case kPhotCutIso: return m_IsoToolVBF->accept(phot);
+      }
+      return true;
+    });
+    if (!passSignal) return EL::StatusCode::SUCCESS;
 
 
-    dec_signal(phot) = true; // For m_goodPhoton container
-    selectDec(phot) = true; // To select objects for Overlap removal
+    m_photFlags->Set(kObjSignal, phot.index()); // For m_goodPhoton container
+    m_photFlags->Set(kObjSelected, phot.index()); // To select objects for Overlap removal
 
     return EL::StatusCode::SUCCESS;
 
@@ -7522,19 +7639,12 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passTauSelection(xAOD::TauJet& tau,
-      const xAOD::EventInfo* eventInfo){
+      const EventContext& ctx){
 
-    dec_baseline(tau) = false;
-    selectDec(tau) = false; // To select objects for Overlap removal
+    m_tauFlags->Clear(tau.index());
 
     // According to https://svnweb.cern.ch/trac/atlasoff/browser/PhysicsAnalysis/TauID/TauAnalysisTools/trunk/README.rst
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passTauSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
-
     // Tau Smearing (for MC)
     if( fabs(tau.eta()) <= 2.5 && tau.nTracks() > 0 && !m_isData){ // it's MC!
       if(m_tauSmearingTool->applyCorrection(tau) == CP::CorrectionCode::Error){ // apply correction and check return code
@@ -7553,8 +7663,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     //Info("execute()", "  Selected tau pt from new Tau Container = %.2f GeV", (tau.pt() * 0.001));
 
-    dec_baseline(tau) = true;
-    selectDec(tau) = true; // To select objects for Overlap removal
+    m_tauFlags->Set(kObjBaseline, tau.index());
+    m_tauFlags->Set(kObjSelected, tau.index()); // To select objects for Overlap removal
 
     return EL::StatusCode::SUCCESS;
 
@@ -7562,20 +7672,12 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
   EL::StatusCode ZinvxAODAnalysis :: passTauVBF(xAOD::TauJet& tau,
-      const xAOD::EventInfo* eventInfo){
+      const EventContext& ctx){
 
-    dec_baseline(tau) = false;
-    dec_signal(tau) = false; // For m_goodTau container
-    selectDec(tau) = false; // To select objects for Overlap removal
+    m_tauFlags->Clear(tau.index());
 
     // According to https://svnweb.cern.ch/trac/atlasoff/browser/PhysicsAnalysis/TauID/TauAnalysisTools/trunk/README.rst
 
-    // Event information
-    if( ! m_event->retrieve( eventInfo, "EventInfo").isSuccess() ){
-      Error("execute()", "Failed to retrieve event info collection in passTauSelection. Exiting." );
-      return EL::StatusCode::FAILURE;
-    }
-
     // Tau Smearing (for MC)
     //if( fabs(tau.eta()) <= 2.5 && tau.nTracks() > 0 && !m_isData){ // it's MC!
     if( (bool) tau.auxdata<char>("IsTruthMatched") && !m_isData){ // it's MC!
@@ -7589,13 +7691,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //Info("execute()", "  original tau pt from new Tau Container = %.2f GeV", (tau.pt() * 0.001));
 
     // TauSelectionTool (Loose for VBF)
-    if(!m_tauSelToolVBF->accept(tau)) return EL::StatusCode::SUCCESS;
+    bool passSelection = m_tauCuts->PassStage(kTauStageSignal, [&](unsigned int) -> bool {
+      return cachedAccept(m_decisionCache, kDecTau, m_tauSelToolVBF, tau, tau.pt());
+    });
+    if (!passSelection) return EL::StatusCode::SUCCESS;
 
     //Info("execute()", "  Selected tau pt from new Tau Container = %.2f GeV", (tau.pt() * 0.001));
 
-    dec_baseline(tau) = true;
-    dec_signal(tau) = true; // For m_goodTau container
-    selectDec(tau) = true; // To select objects for Overlap removal
+    m_tauFlags->Set(kObjBaseline, tau.index());
+    m_tauFlags->Set(kObjSignal, tau.index()); // For m_goodTau container
+    m_tauFlags->Set(kObjSelected, tau.index()); // To select objects for Overlap removal
 
     return EL::StatusCode::SUCCESS;
 
@@ -7616,9 +7721,10 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     if ( jet.pt() < m_jetPtCut || std::abs(jet.eta()) > m_jetEtaCut) return false;
 
     // Jet Cleaning Tool
-    dec_bad(jet) = !m_jetCleaningLoose->accept( jet );
+    bool isBad = !cachedAccept(m_decisionCache, kDecJetCleanLoose, m_jetCleaningLoose, jet, jet.pt());
+    m_jetFlags->Set(kObjBad, jet.index(), isBad);
 
-    return dec_bad(jet);
+    return isBad;
 
   }
 
@@ -7631,8 +7737,8 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     //bool isgoodjet = !dec_bad(jet) && (cacc_jvt(jet) > 0.64 || std::abs(jet.eta()) > 2.4 || jet.pt() > 50000.);
     bool isgoodjet = cacc_jvt(jet) >= 0.64 || std::abs(jet.eta()) >= 2.4 || jet.pt() >= 50000.;
 
-    dec_signal(jet) = isgoodjet; // For m_goodJet container
-    selectDec(jet) = isgoodjet; // To select objects for Overlap removal
+    m_jetFlags->Set(kObjSignal, jet.index(), isgoodjet); // For m_goodJet container
+    m_jetFlags->Set(kObjSelected, jet.index(), isgoodjet); // To select objects for Overlap removal
 
     return isgoodjet;
 
@@ -7672,7 +7778,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
     }
 
     //Info("execute()", "  GetGoodMuonSF: Good Muon SF = %.5f ", sf );
-    dec_scalefactor(mu) = sf;
+    m_muonFlags->SetScaleFactor(mu.index(), sf);
     return sf;
 
   }
@@ -7691,6 +7797,28 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       sf *= GetGoodMuonSF(*muon, recoSF, isoSF, ttvaSF);
     }
 
+    // Scale factor variations of the weight-only systematics filled from the nominal pass
+    if (m_histRegistry->FillingWeightSystematics()) {
+      std::vector<double> nominalSF;
+      for (const auto& muon : muons) nominalSF.push_back(m_muonFlags->ScaleFactor(muon->index()));
+      bool varied = false;
+      for (unsigned int i = 0; i < m_weightSystematics.size(); i++) {
+        const ActiveSystematic &weightSys = m_weightSystematics[i];
+        double sf_var = sf;
+        if (weightSys.dependencies & kSysMuonWeight) {
+          ApplyMuonSFSystematic(m_sysList[weightSys.index]);
+          varied = true;
+          sf_var = 1.;
+          for (const auto& muon : muons) sf_var *= GetGoodMuonSF(*muon, recoSF, isoSF, ttvaSF);
+        }
+        m_histRegistry->SetWeightVariation(kWeightMuon, i, m_histRegistry->WeightVariation(kWeightEvent, i) * sf_var);
+      }
+      if (varied) {
+        ApplyMuonSFSystematic(CP::SystematicSet());
+        for (unsigned int i = 0; i < muons.size(); i++) m_muonFlags->SetScaleFactor(muons[i]->index(), nominalSF[i]);
+      }
+    }
+
     //Info("execute()", "  GetTotalMuonSF: Total Muon SF = %.5f ", sf );
     return sf;
 
@@ -7748,7 +7876,7 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
     //Info("execute()", "  GetGoodElectronSF: Good Electron SF = %.5f ", sf );
-    dec_scalefactor(elec) = sf;
+    m_elecFlags->SetScaleFactor(elec.index(), sf);
     return sf;
 
   }
@@ -7771,6 +7899,29 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       //Info("execute()", "  Good electron pt = %.2f GeV, trig_SF = %d, Electron SF = %.2f", (electron->pt() * 0.001), trig_SF, sf);
     }
 
+    // Scale factor variations of the weight-only systematics filled from the nominal pass
+    if (m_histRegistry->FillingWeightSystematics()) {
+      std::vector<double> nominalSF;
+      for (const auto& electron : electrons) nominalSF.push_back(m_elecFlags->ScaleFactor(electron->index()));
+      bool varied = false;
+      for (unsigned int i = 0; i < m_weightSystematics.size(); i++) {
+        const ActiveSystematic &weightSys = m_weightSystematics[i];
+        double sf_var = sf;
+        if (weightSys.dependencies & kSysElectronWeight) {
+          ApplyElectronSFSystematic(m_sysList[weightSys.index]);
+          varied = true;
+          sf_var = 1.;
+          for (const auto& electron : electrons)
+            sf_var *= GetGoodElectronSF(*electron, recoSF, idSF, isoSF, trigSF && electrons.at(0) == electron);
+        }
+        m_histRegistry->SetWeightVariation(kWeightElectron, i, m_histRegistry->WeightVariation(kWeightEvent, i) * sf_var);
+      }
+      if (varied) {
+        ApplyElectronSFSystematic(CP::SystematicSet());
+        for (unsigned int i = 0; i < electrons.size(); i++) m_elecFlags->SetScaleFactor(electrons[i]->index(), nominalSF[i]);
+      }
+    }
+
     //Info("execute()", "  GetTotalElectronSF: Total Electron SF = %.5f ", sf );
     return sf;
 
@@ -7778,32 +7929,46 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
 
 
-  int ZinvxAODAnalysis :: NumIsoTracks(const xAOD::TrackParticleContainer* inTracks,
-      const xAOD::Vertex* primVertex, float Pt_Low, float Pt_High) {
-    //
-    //  Fill track objects with information about isolated tracks. For being isolated, there should be no track
-    //  above 3 GeV satisfying quality requirement that are within a cone of 0.4 around the probed track.
-    //
-    //============================================================================================================
+  void ZinvxAODAnalysis :: ApplyMuonSFSystematic(const CP::SystematicSet& sys) {
 
-    // Integer to return with this function
-    // ------------------------------------
+    if (m_muonEfficiencySFTool->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure MuonEfficiencyScaleFactorsToolSF for systematics");
+    if (m_muonIsolationSFTool->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure MuonIsolationEfficiencyScaleFactorsToolSF for systematics");
+    if (m_muonTTVAEfficiencySFTool->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure MuonTTVAEfficiencyScaleFactorsToolSF for systematics");
 
-    int NisoTrack = 0;
+  }
 
+  void ZinvxAODAnalysis :: ApplyElectronSFSystematic(const CP::SystematicSet& sys) {
 
-    // Loop over tracks in the event
-    // -----------------------------
+    if (m_elecEfficiencySFTool_reco->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure electronEfficiencyCorrectionToolRecoSF for systematics");
+    if (m_elecEfficiencySFTool_id_Loose->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure electronEfficiencyCorrectionToolIdLooseSF for systematics");
+    if (m_elecEfficiencySFTool_iso_Loose->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure electronEfficiencyCorrectionToolIsoSFlooseID for systematics");
+    if (m_elecEfficiencySFTool_trigSF_Loose->applySystematicVariation(sys) != CP::SystematicCode::Ok)
+      Error("execute()", "Cannot configure electronEfficiencyCorrectionToolTriggerSFloose for systematics");
 
-    for( auto trk_itr : *inTracks ){
+  }
+
+
+
+  void ZinvxAODAnalysis :: FillTrackSummary(const xAOD::TrackParticleContainer* inTracks,
+      const xAOD::Vertex* primVertex, float Pt_Low) {
+    //
+    //  Extract the track variables used by the track based selections once per event and flag the tracks
+    //  above Pt_Low satisfying the quality requirement (|eta|<2.5, |z0|<2, |d0|<1, chi2<3, hits>=5).
+    //
+    //============================================================================================================
 
-      int NCloseby = 0;
+    m_trackSummary.Clear();
+
+    for( auto trk_itr : *inTracks ){
 
-      // Apply quality cuts on the track with Pt>10 GeV
-      // ----------------------------------------------
       float pt   = (trk_itr->pt()) * 0.001; /// GeV
       float eta  = trk_itr->eta();
-      //float phi  = trk_itr->phi();
       float d0   = trk_itr->d0();
       float z0   = (trk_itr->z0() + trk_itr->vz() - primVertex->z());
       int Ndof    = trk_itr->numberDoF();
@@ -7816,56 +7981,73 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
       if(!trk_itr->summaryValue(nSCT,      xAOD::numberOfSCTHits))          Error("PassCuts()", "SCT hits not filled");
       uint8_t NHits   = nSCT + nPix;
 
-      if(pt < Pt_High || fabs(eta) > 2.5 || fabs(z0) >= 2.0 || fabs(d0) >= 1.0 || Chi2 >= 3.0 || NHits < 5) continue;
+      bool pass = !(pt < Pt_Low || fabs(eta) > 2.5 || fabs(z0) >= 2.0 || fabs(d0) >= 1.0 || Chi2 >= 3.0 || NHits < 5);
+
+      m_trackSummary.pt.push_back(pt);
+      m_trackSummary.eta.push_back(eta);
+      m_trackSummary.phi.push_back(trk_itr->phi());
+      m_trackSummary.d0.push_back(d0);
+      m_trackSummary.z0.push_back(z0);
+      m_trackSummary.chi2.push_back(Chi2);
+      m_trackSummary.nHits.push_back(NHits);
+      m_trackSummary.pass.push_back(pass);
+    }
+  }
+
 
-      // Loop over *other* tracks and apply quality cuts too
-      // ---------------------------------------------------
+  void ZinvxAODAnalysis :: FillIsoTrackGrid() {
+    //
+    //  Fill the track grid with the quality tracks of the track summary (see FillTrackSummary). Called once
+    //  per event, the isolated track functions below only read the grid.
+    //
+    //============================================================================================================
+
+    m_isoTrackGrid->Clear();
+
+    for (unsigned int i = 0; i < m_trackSummary.Size(); i++) {
+      if (!m_trackSummary.pass[i]) continue;
+      m_isoTrackGrid->Add(m_trackSummary.pt[i], m_trackSummary.eta[i], m_trackSummary.phi[i]);
+    }
+
+    m_isoTrackGrid->Build();
+  }
 
-      for( auto trk2_itr : *inTracks ){
 
-        if ( trk2_itr == trk_itr ) continue;
+  int ZinvxAODAnalysis :: NumIsoTracks(float Pt_Low, float Pt_High) {
+    //
+    //  Fill track objects with information about isolated tracks. For being isolated, there should be no track
+    //  above 3 GeV satisfying quality requirement that are within a cone of 0.4 around the probed track.
+    //  The quality tracks are taken from the track grid (see FillIsoTrackGrid).
+    //
+    //============================================================================================================
 
-        float pt_2   = (trk2_itr->pt()) * 0.001; /// GeV
-        float eta_2  = trk2_itr->eta();
-        //float phi_2  = trk2_itr->phi();
-        float d0_2   = trk2_itr->d0();
-        float z0_2   = (trk2_itr->z0() + trk2_itr->vz() - primVertex->z());
-        int Ndof_2    = trk2_itr->numberDoF();
-        if (Ndof_2==0) Ndof_2 = 1;
+    // Integer to return with this function
+    // ------------------------------------
 
-        float Chi2_2 = trk2_itr->chiSquared()/Ndof_2;
-        uint8_t nSCT_2      = -1;
-        uint8_t nPix_2      = -1;
-        if(!trk2_itr->summaryValue(nPix_2,      xAOD::numberOfPixelHits))        Error("PassCuts()", "Pix hits not filled");
-        if(!trk2_itr->summaryValue(nSCT_2,      xAOD::numberOfSCTHits))          Error("PassCuts()", "SCT hits not filled");
-        uint8_t NHits_2   = nSCT_2 + nPix_2;
+    int NisoTrack = 0;
 
-        if(pt_2 < Pt_Low || fabs(eta_2) > 2.5 || fabs(z0_2) >= 2.0 || fabs(d0_2) >= 1.0 || Chi2_2 >= 3.0 || NHits_2 < 5) continue;
 
-        float dR = trk2_itr->p4().DeltaR(trk_itr->p4());
-        //Info("execute()", "  dR(track1 with pt=%f, track2 with pt=%f) = %f ", pt, pt_2, dR);
+    // Loop over quality tracks with Pt>10 GeV
+    // ---------------------------------------
 
-        // Count the number of track in a 0.4 cone around the probed track
-        // ---------------------------------------------------------------
+    for (unsigned int i = 0; i < m_isoTrackGrid->Size(); i++) {
 
-        if(dR < 0.4) NCloseby++;
-      } // end 2nd loop
+      if (m_isoTrackGrid->Pt(i) < Pt_High) continue;
 
-      // Fill the vertex collection
-      // --------------------------
+      // Count the number of *other* tracks in a 0.4 cone around the probed track
+      // ------------------------------------------------------------------------
 
-      // Note: The object properties are: E, pT, eta, phi, d0, d0_err, d0_vx, d0_err_vx, charge, n_SCTHits, n_PixelHits
+      int NCloseby = m_isoTrackGrid->NumNeighbours(m_isoTrackGrid->Eta(i), m_isoTrackGrid->Phi(i), Pt_Low, i);
 
       if (NCloseby < 1) NisoTrack++;
 
-    } // end 1st loop
+    } // end loop
 
     return NisoTrack;
   }
 
 
-  int ZinvxAODAnalysis :: NumMuonIsoTrack(xAOD::MuonContainer* muons, const xAOD::TrackParticleContainer* inTracks,
-      const xAOD::Vertex* primVertex, float Pt_Low, float Pt_High) {
+  int ZinvxAODAnalysis :: NumMuonIsoTrack(xAOD::MuonContainer* muons, float Pt_Low, float Pt_High) {
     //
     //  Apply the same criteria as in the SetIsoTracks function to determine how many muons are isolated
     //  according to this definition.
@@ -7883,47 +8065,16 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     for (const auto& muon_itr : *muons) { // C++11 shortcut
 
-      int NCloseby = 0;
-
       // Apply muon cuts on the baseline muon with pT>10GeV
       float muon_pt = (muon_itr->pt()) * 0.001; /// GeV
 
       //if (!dec_baseline(muon_itr) || !m_IsolationSelectionTool->accept(muon_itr)) continue; 
-      if (!dec_baseline(*muon_itr) || muon_pt < Pt_High) continue; 
-
-      // Loop over *other* tracks and apply quality cuts too
-      // ---------------------------------------------------
-
-      for( auto trk_itr : *inTracks ){
-
-        // Apply quality cuts on the track with Pt>3 GeV
-        // ----------------------------------------------
-        float pt   = (trk_itr->pt()) * 0.001; /// GeV
-        float eta  = trk_itr->eta();
-        //float phi  = trk_itr->phi();
-        float d0   = trk_itr->d0();
-        float z0   = (trk_itr->z0() + trk_itr->vz() - primVertex->z());
-        int Ndof    = trk_itr->numberDoF();
-        if (Ndof==0) Ndof = 1;
-
-        float Chi2 = trk_itr->chiSquared()/Ndof;
-        uint8_t nSCT      = -1;
-        uint8_t nPix      = -1;
-        if(!trk_itr->summaryValue(nPix,      xAOD::numberOfPixelHits))        Error("PassCuts()", "Pix hits not filled");
-        if(!trk_itr->summaryValue(nSCT,      xAOD::numberOfSCTHits))          Error("PassCuts()", "SCT hits not filled");
-        uint8_t NHits   = nSCT + nPix;
-
-        if(pt < Pt_Low || fabs(eta) > 2.5 || fabs(z0) >= 2.0 || fabs(d0) >= 1.0 || Chi2 >= 3.0 || NHits < 5) continue;
-
-
-        float dR = trk_itr->p4().DeltaR(muon_itr->p4());
-        //Info("execute()", "  dR(Muon with pt=%f, track with pt=%f) = %f ", muon_pt, pt, dR);
+      if (!m_muonFlags->Get(kObjBaseline, muon_itr->index()) || muon_pt < Pt_High) continue; 
 
-        // Count the number of track in a 0.4 cone around the probed track
-        // ---------------------------------------------------------------
+      // Count the number of quality tracks with Pt>3 GeV in a 0.4 cone around the muon
+      // ------------------------------------------------------------------------------
 
-        if(dR < 0.4) NCloseby++;
-      } // end 2nd loop
+      int NCloseby = m_isoTrackGrid->NumNeighbours(muon_itr->eta(), muon_itr->phi(), Pt_Low);
 
       // Count the number of isolated muon in the event following track iso criteria
       // ---------------------------------------------------------------------------
@@ -7938,14 +8089,13 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
       if (NCloseby <= 1) NisoMuon++;
 
-    } // end 1st loop
+    } // end loop
 
     return NisoMuon;
   }
 
 
-  int ZinvxAODAnalysis :: NumElecIsoTrack(xAOD::ElectronContainer* electrons, const xAOD::TrackParticleContainer* inTracks,
-      const xAOD::Vertex* primVertex, float Pt_Low, float Pt_High) {
+  int ZinvxAODAnalysis :: NumElecIsoTrack(xAOD::ElectronContainer* electrons, float Pt_Low, float Pt_High) {
     //
     //  Apply the same criteria as in the SetIsoTracks function to determine how many electrons are isolated
     //  according to this definition.
@@ -7963,54 +8113,23 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
     for (const auto& elec_itr : *electrons) { // C++11 shortcut
 
-      int NCloseby = 0;
-
       // Apply electron cuts on the baseline electron with pT>10GeV
       float elec_pt = (elec_itr->pt()) * 0.001; /// GeV
 
       //if (!dec_baseline(elec_itr) || !m_IsolationSelectionTool->accept(elec_itr)) continue; 
-      if (!dec_baseline(*elec_itr) || elec_pt < Pt_High) continue; 
-
-      // Loop over *other* tracks and apply quality cuts too
-      // ---------------------------------------------------
-
-      for( auto trk_itr : *inTracks ){
-
-        // Apply quality cuts on the track with Pt>3 GeV
-        // ----------------------------------------------
-        float pt   = (trk_itr->pt()) * 0.001; /// GeV
-        float eta  = trk_itr->eta();
-        //float phi  = trk_itr->phi();
-        float d0   = trk_itr->d0();
-        float z0   = (trk_itr->z0() + trk_itr->vz() - primVertex->z());
-        int Ndof    = trk_itr->numberDoF();
-        if (Ndof==0) Ndof = 1;
-
-        float Chi2 = trk_itr->chiSquared()/Ndof;
-        uint8_t nSCT      = -1;
-        uint8_t nPix      = -1;
-        if(!trk_itr->summaryValue(nPix,      xAOD::numberOfPixelHits))        Error("PassCuts()", "Pix hits not filled");
-        if(!trk_itr->summaryValue(nSCT,      xAOD::numberOfSCTHits))          Error("PassCuts()", "SCT hits not filled");
-        uint8_t NHits   = nSCT + nPix;
-
-        if(pt < Pt_Low || fabs(eta) > 2.5 || fabs(z0) >= 2.0 || fabs(d0) >= 1.0 || Chi2 >= 3.0 || NHits < 5) continue;
-
-
-        float dR = trk_itr->p4().DeltaR(elec_itr->p4());
-        //Info("execute()", "  dR(Electron with pt=%f, track with pt=%f) = %f ", elec_pt, pt, dR);
+      if (!m_elecFlags->Get(kObjBaseline, elec_itr->index()) || elec_pt < Pt_High) continue; 
 
-        // Count the number of track in a 0.4 cone around the probed track
-        // ---------------------------------------------------------------
+      // Count the number of quality tracks with Pt>3 GeV in a 0.4 cone around the electron
+      // ----------------------------------------------------------------------------------
 
-        if(dR < 0.4) NCloseby++;
-      } // end 2nd loop
+      int NCloseby = m_isoTrackGrid->NumNeighbours(elec_itr->eta(), elec_itr->phi(), Pt_Low);
 
       // Count the number of isolated elec in the event following track iso criteria
       // ---------------------------------------------------------------------------
 
       if (NCloseby <= 1) NisoElec++;
 
-    } // end 1st loop
+    } // end loop
 
     return NisoElec;
   }
@@ -8039,5 +8158,111 @@ EL::StatusCode ZinvxAODAnalysis :: execute ()
 
   }
 
+
+
+  //------------------------------------------------------------------
+  // Rebuild the MET of a hypothesis: the electron, tau and muon terms
+  // (null: not added), then the invisible objects, jets and soft terms
+  //------------------------------------------------------------------
+  void ZinvxAODAnalysis :: RebuildEmulatedMET(xAOD::MissingETContainer* met,
+      const xAOD::MissingETContainer* metCore, const xAOD::MissingETAssociationMap* metMap,
+      const std::string& softTerm, const xAOD::ElectronContainer* electrons,
+      const xAOD::TauJetContainer* taus, const xAOD::MuonContainer* muons,
+      const xAOD::IParticleContainer* invisibles, const xAOD::JetContainer* jets,
+      float& met_final, float& met_phi, float& met_CST){
+
+    // It is necessary to reset the selected objects before every MET calculation
+    met->clear();
+    metMap->resetObjSelectionFlags();
+
+    if (electrons) m_metMaker->rebuildMET("RefElectron", xAOD::Type::Electron, met, electrons, metMap);
+    if (taus) m_metMaker->rebuildMET("RefTau", xAOD::Type::Tau, met, taus, metMap);
+    if (muons) m_metMaker->rebuildMET("RefMuon", xAOD::Type::Muon, met, muons, metMap);
+    if (invisibles) m_metMaker->markInvisible(invisibles, metMap);
+
+    m_metMaker->rebuildJetMET("RefJet", "SoftClus", "PVSoftTrk", met, jets, metCore, metMap, true);
+
+    // Soft term uncertainties
+    if (!m_isData) {
+      xAOD::MissingET* softTrkmet = (*met)[softTerm];
+      if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
+        Error("execute()", "METSystematicsTool returns Error CorrectionCode");
+      }
+    }
+
+    m_metMaker->buildMETSum("Final", met, (*met)[softTerm]->source());
+    m_metMaker->buildMETSum("FinalClus", met, (*met)["SoftClus"]->source());
+
+    met_final = (*met)["Final"]->met();
+    met_phi = (*met)["Final"]->phi();
+    met_CST = (*met)["FinalClus"]->met();
+
+  }
+
+
+
+  //-------------------------------------------------------------------
+  // Largest change of the (uncorrected) soft term between the soft term
+  // variations of the selection passes and the current one; the soft
+  // term and the tool configuration are left as they were
+  //-------------------------------------------------------------------
+  bool ZinvxAODAnalysis :: SoftTermEnvelopeShift(xAOD::MissingET* softTrkmet,
+      const CP::SystematicSet& currentSys, float& maxShift){
+
+    maxShift = 0;
+    if (m_softTermSystematics.empty()) return true;
+
+    const float mpx = softTrkmet->mpx(), mpy = softTrkmet->mpy(), sumet = softTrkmet->sumet();
+    if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
+      Error("execute()", "METSystematicsTool returns Error CorrectionCode");
+    }
+    const float currentMpx = softTrkmet->mpx(), currentMpy = softTrkmet->mpy();
+
+    for (const auto &sysList : m_softTermSystematics) {
+      if (m_metSystTool->applySystematicVariation(sysList) != CP::SystematicCode::Ok) {
+        Error("execute()", "Cannot configure METSystematicsTool for systematics");
+        return false;
+      }
+      softTrkmet->setMpx(mpx);
+      softTrkmet->setMpy(mpy);
+      softTrkmet->setSumet(sumet);
+      if (m_metSystTool->applyCorrection(*softTrkmet) != CP::CorrectionCode::Ok) {
+        Error("execute()", "METSystematicsTool returns Error CorrectionCode");
+      }
+      const float dx = softTrkmet->mpx() - currentMpx, dy = softTrkmet->mpy() - currentMpy;
+      maxShift = std::max(maxShift, float(TMath::Sqrt(dx*dx + dy*dy)));
+    }
+
+    softTrkmet->setMpx(mpx);
+    softTrkmet->setMpy(mpy);
+    softTrkmet->setSumet(sumet);
+    if (m_metSystTool->applySystematicVariation(currentSys) != CP::SystematicCode::Ok) {
+      Error("execute()", "Cannot configure METSystematicsTool for systematics");
+      return false;
+    }
+    return true;
+
+  }
+
+
+
+  //---------------------------------------------------------------
+  // Compare a MET hypothesis from the real MET terms with its rebuild
+  //---------------------------------------------------------------
+  void ZinvxAODAnalysis :: CompareEmulatedMET(const char* hypothesis, float met, float met_phi,
+      float rebuiltMET, float rebuiltMET_phi){
+
+    m_numEmulMETCompared++;
+    // 1 MeV, and the phi of a MET above 1 GeV
+    bool same = std::fabs(met - rebuiltMET) < 1.;
+    if (rebuiltMET > 1000.) same = same && deltaPhi(met_phi, rebuiltMET_phi) < 1e-4;
+    if (same) return;
+    m_numEmulMETMismatches++;
+    if (m_numEmulMETMismatches <= 10)
+      Warning("execute()", "Emulated MET %s differs from its rebuild: %.3f GeV (phi %.4f), rebuilt %.3f GeV (phi %.4f)",
+          hypothesis, met * 0.001, met_phi, rebuiltMET * 0.001, rebuiltMET_phi);
+
+  }
+
    
 
@@ -4,12 +4,16 @@
 #include <TH1I.h>
 #include <iostream>
 #include <map>
-#include <bitset>
+#include <string>
+#include <vector>
 
 #include "EventLoop/Worker.h"
 
 using namespace std;
 
+/// Event cutflow. Steps are registered once and filled through their integer
+/// handle; a step counts at most once per event. The counts are kept in plain
+/// counters and written to cutflow_hist by Flush() (call it in finalize()).
 class BitsetCutflow
 {
 
@@ -17,22 +21,41 @@ public:
 	BitsetCutflow(EL::Worker *wk);
 	~BitsetCutflow();
 
-	void FillCutflow(string cutflowStepName, bool fillCutflow = true);
+	/// Handle of a step, registered (next bin) if the name is not known yet
+	unsigned int RegisterStep(const string& cutflowStepName);
+
+	inline unsigned int NumSteps() const { return m_stepNames.size(); }
+
+	/// Mark a step as passed in the current event
+	inline void Fill(unsigned int step) {
+		if (m_stepEvent[step] == m_numEvents) return;
+		m_stepEvent[step] = m_numEvents;
+		m_stepCounts[step]++;
+	}
+
+	/// Name-based filling, registering new steps on first use
+	void FillCutflow(const string& cutflowStepName, bool fillCutflow = true);
 	void PrintCutflowLocally();
         
 	/// WARNING call this function on the BEGIN of EVENT!!!
 	/// WARNING call this function in the finalize() function!!!
 	void PushBitSet();
+
+	/// Write the counts to cutflow_hist
+	void Flush();
 	
 private:
 	
-	unsigned int m_cutflowStepCounter; //!
-	
 	/// link to EventLoop worker;
 	EL::Worker *m_wk; //!
 	
-	/// actual bitset were we will store cutflow on event-by-event basis
-	bitset<99> m_bitset; //!
+	/// PushBitSet() calls: the current event number, plus one
+	unsigned long long m_numEvents; //!
+
+	/// steps in registration order, with their count and the last event they were filled in
+	vector<string> m_stepNames; //!
+	vector<unsigned long long> m_stepCounts; //!
+	vector<unsigned long long> m_stepEvent; //!
 	
 	/// map with cutflow steps
 	map<string,unsigned int> m_mapCutflowSteps; //!
@@ -0,0 +1,90 @@
+#ifndef CutChain_H
+#define CutChain_H
+
+#include <Rtypes.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// Cut chain of an object selection. The cuts are grouped in stages: all
+/// cuts of a stage must be side-effect free predicates whose AND does not
+/// depend on their order, stages are evaluated in the order the selection
+/// function calls them (decorations and corrections happen between stages).
+/// During the warm-up the cost and pass rate of each cut are measured; the
+/// cuts of each stage are then ordered by increasing cost / rejection.
+class CutChain
+{
+
+public:
+	CutChain(const std::string& name = "");
+	~CutChain();
+
+	/// Declare a cut of a stage, returns its id (0, 1, ... in declaration order)
+	unsigned int AddCut(unsigned int stage, const std::string& name);
+
+	/// Number of stage evaluations before reordering, timing prescale afterwards
+	void SetWarmUp(long long numWarmUp, unsigned int timingPrescale = 64);
+
+	/// Reorder the stages after the warm-up (otherwise only measure)
+	void SetAdaptive(bool adaptive) { m_adaptive = adaptive; }
+
+	/// Evaluate the cuts of a stage; cut(id) returns the decision of cut id
+	template <class Cut>
+	bool PassStage(unsigned int stage, Cut cut);
+
+	/// Print the per-cut timing, efficiency and the current order
+	void Report() const;
+
+private:
+
+	void Reorder();
+
+	std::string m_name; //!
+	bool m_adaptive; //!
+	bool m_reordered; //!
+	long long m_numWarmUp; //!
+	unsigned int m_timingPrescale; //!
+	long long m_numEvaluations; //!
+
+	std::vector<std::string> m_cutName; //!
+	std::vector<unsigned int> m_cutStage; //!
+	std::vector<std::vector<unsigned int> > m_stageOrder; //!
+
+	std::vector<long long> m_numCalls; //!
+	std::vector<long long> m_numPass; //!
+	std::vector<long long> m_numTimed; //!
+	std::vector<double> m_time; //! seconds
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(CutChain, 1);
+
+};
+
+
+template <class Cut>
+bool CutChain::PassStage(unsigned int stage, Cut cut) {
+  const bool warmUp = m_adaptive && !m_reordered;
+  const bool timed = warmUp || m_numEvaluations % m_timingPrescale == 0;
+  m_numEvaluations++;
+
+  bool pass = true;
+  const std::vector<unsigned int> &order = m_stageOrder[stage];
+  for (unsigned int k = 0; k < order.size(); k++) {
+    const unsigned int id = order[k];
+    if (timed) {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      pass = cut(id);
+      m_time[id] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      m_numTimed[id]++;
+    }
+    else pass = cut(id);
+    m_numCalls[id]++;
+    if (!pass) break;
+    m_numPass[id]++;
+  }
+
+  if (warmUp && m_numEvaluations >= m_numWarmUp) Reorder();
+  return pass;
+}
+
+#endif
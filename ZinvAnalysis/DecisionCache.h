@@ -0,0 +1,71 @@
+#ifndef DecisionCache_H
+#define DecisionCache_H
+
+#include <Rtypes.h>
+#include <vector>
+
+/// Object decisions kept across the systematic passes of an event
+enum ObjectDecision {
+  kDecMuonLoose,      /// MuonSelectionTool (Loose)
+  kDecElectronOQ,     /// isGoodOQ(BADCLUSELECTRON)
+  kDecElectronLH,     /// LH Loose identification
+  kDecTau,            /// TauSelectionTool (VBF)
+  kDecJetCleanLoose,  /// JetCleaningTool (LooseBad)
+  kDecJetCleanTight,  /// JetCleaningTool (TightBad)
+  kDecBTag,           /// BTaggingSelectionTool
+  kNumObjectDecisions
+};
+
+/// When a cached decision may be reused for the same object in another pass
+enum DecisionRule {
+  kRuleAlways,    /// does not depend on the object kinematics
+  kRuleSameKey,   /// only if the key (e.g. pt) is unchanged
+  kRuleSameSide   /// only if the key is on the same side of the rule threshold
+};
+
+/// Per-event cache of object decisions keyed by the index of the object in
+/// its original container (shallow copies keep the index), so that the
+/// decisions which do not change under a systematic variation are taken
+/// once per event instead of once per systematic pass.
+class DecisionCache
+{
+
+public:
+	DecisionCache();
+	~DecisionCache();
+
+	/// Invalidation rule of a decision (kRuleAlways by default)
+	void SetRule(unsigned int decision, DecisionRule rule, float threshold = 0.);
+
+	/// Forget all decisions (call once per event)
+	void Clear();
+
+	/// Cached decision (0 or 1), -1 if none or invalidated by the key
+	int Get(unsigned int decision, unsigned int index, float key);
+
+	/// Store a decision
+	void Set(unsigned int decision, unsigned int index, float key, bool accept);
+
+	inline long long NumHits(unsigned int decision) const { return m_numHits[decision]; }
+	inline long long NumMisses(unsigned int decision) const { return m_numMisses[decision]; }
+
+	static const char* Name(unsigned int decision);
+
+private:
+
+	DecisionRule m_rule[kNumObjectDecisions]; //!
+	float m_threshold[kNumObjectDecisions]; //!
+
+	/// per decision, indexed by the object index: -1 (none), 0 or 1
+	std::vector<char> m_state[kNumObjectDecisions]; //!
+	std::vector<float> m_key[kNumObjectDecisions]; //!
+
+	long long m_numHits[kNumObjectDecisions]; //!
+	long long m_numMisses[kNumObjectDecisions]; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(DecisionCache, 1);
+
+};
+
+#endif
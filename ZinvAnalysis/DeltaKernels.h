@@ -0,0 +1,24 @@
+#ifndef DeltaKernels_H
+#define DeltaKernels_H
+
+/// Batch versions of ZinvxAODAnalysis::deltaPhi and deltaR. The phi values are
+/// expected in [-pi, pi] as returned by the xAOD objects. The kernels use AVX or
+/// SSE when the compiler enables them (__AVX__, __SSE2__) and a scalar loop
+/// otherwise; the *Scalar versions always use the scalar loop (see
+/// test/ut_DeltaKernels.cxx and util/benchDeltaKernels.cxx).
+
+/// dPhi[i] = deltaPhi(phi[i], phiRef), i < n
+void DeltaPhiOneToMany(float phiRef, const float* phi, float* dPhi, unsigned int n);
+void DeltaPhiOneToManyScalar(float phiRef, const float* phi, float* dPhi, unsigned int n);
+
+/// dR[i] = deltaR(eta[i], etaRef, phi[i], phiRef), i < n
+void DeltaROneToMany(float etaRef, float phiRef, const float* eta, const float* phi, float* dR, unsigned int n);
+void DeltaROneToManyScalar(float etaRef, float phiRef, const float* eta, const float* phi, float* dR, unsigned int n);
+
+/// dR[i*n2 + j] = deltaR(eta1[i], eta2[j], phi1[i], phi2[j]), i < n1, j < n2
+void DeltaRPairwise(const float* eta1, const float* phi1, unsigned int n1,
+		const float* eta2, const float* phi2, unsigned int n2, float* dR);
+void DeltaRPairwiseScalar(const float* eta1, const float* phi1, unsigned int n1,
+		const float* eta2, const float* phi2, unsigned int n2, float* dR);
+
+#endif
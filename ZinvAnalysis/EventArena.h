@@ -0,0 +1,165 @@
+#ifndef EventArena_H
+#define EventArena_H
+
+#include <Rtypes.h>
+#include <utility>
+#include <vector>
+
+#include "AthContainers/AuxVectorData.h"
+#include "xAODCore/ShallowAuxContainer.h"
+#include "xAODCore/ShallowCopy.h"
+
+/// Owner of the containers used while processing an event. The containers of
+/// a slot are created on first use and only cleared afterwards, so their
+/// capacity is reused from event to event. Shallow copies live until the end
+/// of the event: those of a slot are made once per event and, when the slot is
+/// requested again, reset to the values of their input instead of being made
+/// again. Calling Reset() at the start of an event also frees whatever an
+/// early return of the previous event left behind.
+class EventArena
+{
+
+public:
+	EventArena();
+	~EventArena();
+
+	/// View container (SG::VIEW_ELEMENTS) of a slot, empty on return
+	template <class T>
+	T* View(unsigned int slot);
+
+	/// Container of a slot with its own aux store, empty on return
+	template <class T, class Aux>
+	T* Container(unsigned int slot);
+
+	/// Take ownership of a shallow copy until the end of the event
+	template <class T>
+	std::pair< T*, xAOD::ShallowAuxContainer* > Adopt(std::pair< T*, xAOD::ShallowAuxContainer* > copy);
+
+	/// Shallow copy of input kept in a slot for the event. When the slot was
+	/// already used in this event, the variables the copy holds itself are reset
+	/// to the input values (decorations missing in the input are left as they
+	/// are) and reused is set: the aux store and the object links are kept.
+	template <class T>
+	std::pair< T*, xAOD::ShallowAuxContainer* > ShallowCopy(unsigned int slot, const T& input, bool& reused);
+
+	/// Clear all containers and delete all shallow copies (call once per event)
+	void Reset();
+
+	/// Allocations made for the current event, and over all events
+	inline long long NumAllocations() const { return m_numAllocations; }
+	inline long long TotalAllocations() const { return m_totalAllocations; }
+	inline long long MaxAllocations() const { return m_maxAllocations; }
+	inline long long NumReuses() const { return m_numReuses; }
+	inline long long NumEvents() const { return m_numEvents; }
+
+private:
+
+	struct Entry {
+		void* object;
+		void* aux;
+		void (*clear)(void* object);
+		void (*destroy)(void* object, void* aux);
+	};
+
+	template <class T>
+	static void ClearObject(void* object) { static_cast<T*>(object)->clear(); }
+
+	template <class T, class Aux>
+	static void DestroyObject(void* object, void* aux) {
+		delete static_cast<T*>(object);
+		delete static_cast<Aux*>(aux);
+	}
+
+	template <class T>
+	static void DestroyView(void* object, void*) { delete static_cast<T*>(object); }
+
+	/// Slot entry, or 0 (and a free slot) if the slot is not used yet
+	Entry* Find(unsigned int slot);
+
+	static void Destroy(std::vector<Entry> &entries);
+
+	/// Copy the input values of the variables held by a shallow aux store
+	static void RestoreFromInput(xAOD::ShallowAuxContainer* aux, const SG::AuxVectorData& input);
+
+	std::vector<Entry> m_slots; //!
+	std::vector<Entry> m_eventCopies; //!
+	/// shallow copy of each copy slot in this event, 0 if not made yet
+	std::vector< std::pair<void*, xAOD::ShallowAuxContainer*> > m_copySlots; //!
+
+	long long m_numAllocations; //!
+	long long m_totalAllocations; //!
+	long long m_maxAllocations; //!
+	long long m_numReuses; //!
+	long long m_numEvents; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(EventArena, 1);
+
+};
+
+
+template <class T>
+T* EventArena::View(unsigned int slot) {
+  Entry* entry = Find(slot);
+  if (entry->object) {
+    m_numReuses++;
+    static_cast<T*>(entry->object)->clear();
+  }
+  else {
+    entry->object = new T(SG::VIEW_ELEMENTS);
+    entry->clear = &ClearObject<T>;
+    entry->destroy = &DestroyView<T>;
+    m_numAllocations++;
+  }
+  return static_cast<T*>(entry->object);
+}
+
+template <class T, class Aux>
+T* EventArena::Container(unsigned int slot) {
+  Entry* entry = Find(slot);
+  if (entry->object) {
+    m_numReuses++;
+    static_cast<T*>(entry->object)->clear();
+  }
+  else {
+    T* container = new T();
+    Aux* aux = new Aux();
+    container->setStore(aux);
+    entry->object = container;
+    entry->aux = aux;
+    entry->clear = &ClearObject<T>;
+    entry->destroy = &DestroyObject<T, Aux>;
+    m_numAllocations += 2;
+  }
+  return static_cast<T*>(entry->object);
+}
+
+template <class T>
+std::pair< T*, xAOD::ShallowAuxContainer* > EventArena::Adopt(std::pair< T*, xAOD::ShallowAuxContainer* > copy) {
+  Entry entry;
+  entry.object = copy.first;
+  entry.aux = copy.second;
+  entry.clear = 0;
+  entry.destroy = &DestroyObject<T, xAOD::ShallowAuxContainer>;
+  m_eventCopies.push_back(entry);
+  m_numAllocations += 2;
+  return copy;
+}
+
+template <class T>
+std::pair< T*, xAOD::ShallowAuxContainer* > EventArena::ShallowCopy(unsigned int slot, const T& input, bool& reused) {
+  if (slot >= m_copySlots.size()) m_copySlots.resize(slot + 1, std::pair<void*, xAOD::ShallowAuxContainer*>(0, 0));
+  std::pair<void*, xAOD::ShallowAuxContainer*> &copy = m_copySlots[slot];
+  reused = copy.first != 0;
+  if (reused) {
+    RestoreFromInput(copy.second, input);
+    m_numReuses++;
+    return std::pair< T*, xAOD::ShallowAuxContainer* >(static_cast<T*>(copy.first), copy.second);
+  }
+  std::pair< T*, xAOD::ShallowAuxContainer* > newCopy = Adopt(xAOD::shallowCopyContainer(input));
+  copy.first = newCopy.first;
+  copy.second = newCopy.second;
+  return newCopy;
+}
+
+#endif
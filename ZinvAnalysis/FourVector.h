@@ -0,0 +1,61 @@
+#ifndef FourVector_H
+#define FourVector_H
+
+#include <cmath>
+
+/// Minimal (px, py, pz, E) four-vector for the invariant and transverse mass
+/// computations in execute(). Trivially copyable, no virtual functions, with
+/// the same conventions as TLorentzVector (SetPtEtaPhiM(), M(), Rapidity(),
+/// DeltaR(), ...) so that results agree with the TLorentzVector versions.
+struct FourVector
+{
+  double px;
+  double py;
+  double pz;
+  double e;
+
+  constexpr FourVector() : px(0.), py(0.), pz(0.), e(0.) {}
+  constexpr FourVector(double x, double y, double z, double t) : px(x), py(y), pz(z), e(t) {}
+
+  static inline FourVector PtEtaPhiM(double pt, double eta, double phi, double m) {
+    const double x = pt * std::cos(phi), y = pt * std::sin(phi), z = pt * std::sinh(eta);
+    const double p2 = x*x + y*y + z*z;
+    return FourVector(x, y, z, m >= 0 ? std::sqrt(p2 + m*m) : std::sqrt(std::fmax(p2 - m*m, 0.)));
+  }
+
+  static inline FourVector PtEtaPhiE(double pt, double eta, double phi, double energy) {
+    return FourVector(pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta), energy);
+  }
+
+  constexpr FourVector operator+(const FourVector& other) const {
+    return FourVector(px + other.px, py + other.py, pz + other.pz, e + other.e);
+  }
+
+  inline FourVector& operator+=(const FourVector& other) {
+    px += other.px; py += other.py; pz += other.pz; e += other.e;
+    return *this;
+  }
+
+  constexpr double M2() const { return e*e - (px*px + py*py + pz*pz); }
+  constexpr double Pt2() const { return px*px + py*py; }
+
+  inline double M() const { const double m2 = M2(); return m2 < 0 ? -std::sqrt(-m2) : std::sqrt(m2); }
+  inline double Pt() const { return std::sqrt(Pt2()); }
+  inline double Phi() const { return (px == 0. && py == 0.) ? 0. : std::atan2(py, px); }
+  inline double Eta() const { return std::asinh(pz / Pt()); }
+  inline double Rapidity() const { return 0.5 * std::log((e + pz) / (e - pz)); }
+
+  inline double DeltaR(const FourVector& other) const {
+    const double dEta = Eta() - other.Eta();
+    double dPhi = std::fabs(Phi() - other.Phi());
+    if (dPhi > M_PI) dPhi = 2. * M_PI - dPhi;
+    return std::sqrt(dEta*dEta + dPhi*dPhi);
+  }
+};
+
+/// Transverse mass of a lepton and the MET
+inline double TransverseMass(double pt, double phi, double met, double metPhi) {
+  return std::sqrt(2. * pt * met * (1. - std::cos(phi - metPhi)));
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef HistRegistry_H
+#define HistRegistry_H
+
+#include <TH1.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Channel a histogram belongs to ("h_znunu_", "Znunu_", ...)
+enum HistChannel {
+  kChInclusive, /// no channel tag (e.g. "avg_interaction")
+  kChZnunu,
+  kChZmumu,
+  kChWmunu,
+  kChZee,
+  kChWenu,
+  kNumHistChannels
+};
+
+/// Region (name prefix after the channel tag)
+enum HistRegion {
+  kRegNone,
+  kRegMonojet,      /// "monojet_"
+  kRegVBF,          /// "vbf_"
+  kRegSM1,          /// "sm1_"
+  kRegTruthMonojet, /// "truth_monojet_"
+  kRegTruthVBF,     /// "truth_vbf_"
+  kRegRatio,        /// "Znunu_MET_mono", ... (ratio plots)
+  kRegEmily,        /// "Emily_Zee_MET_mono", ... (cross-check cutflow)
+  kNumHistRegions
+};
+
+/// Variable (name suffix); keep in sync with the name table in HistRegistry.cxx
+enum HistVariable {
+  kVar_avg_interaction,
+  kVar_MET_mono,
+  kVar_MET_search,
+  kVar_Mjj_search,
+  kVar_DeltaPhiAll,
+  kVar_met,
+  kVar_mjj,
+  kVar_dPhijj,
+  kVar_njet,
+  kVar_jet_pt,
+  kVar_jet_phi,
+  kVar_jet_eta,
+  kVar_jet_rap,
+  kVar_dPhimetjet,
+  kVar_dPhiMinmetjet,
+  kVar_jet1_pt,
+  kVar_jet2_pt,
+  kVar_jet3_pt,
+  kVar_jet1_phi,
+  kVar_jet2_phi,
+  kVar_jet3_phi,
+  kVar_jet1_eta,
+  kVar_jet2_eta,
+  kVar_jet3_eta,
+  kVar_jet1_rap,
+  kVar_jet2_rap,
+  kVar_jet3_rap,
+  kVar_dRjj,
+  kVar_dPhimetj1,
+  kVar_dPhimetj2,
+  kVar_dPhimetj3,
+  kVar_met_emulmet,
+  kVar_met_emulmet_1bJet,
+  kVar_mjj_1bJet,
+  kVar_dPhijj_1bJet,
+  kVar_met_emulmet_2bJet,
+  kVar_mjj_2bJet,
+  kVar_dPhijj_2bJet,
+  kVar_lepton1_pt,
+  kVar_lepton2_pt,
+  kVar_lepton1_phi,
+  kVar_lepton2_phi,
+  kVar_lepton1_eta,
+  kVar_lepton2_eta,
+  kVar_mll,
+  kVar_eff_study_met_emulmet,
+  kVar_eff_study_met_emulmet_pass_HLT_xe70,
+  kVar_eff_study_met_emulmet_pass_HLT_xe70_tclcw,
+  kVar_eff_study_mjj_allmet,
+  kVar_eff_study_dPhijj_allmet,
+  kVar_eff_study_mjj_allmet_pass_HLT_xe70,
+  kVar_eff_study_dPhijj_allmet_pass_HLT_xe70,
+  kVar_eff_study_mjj_allmet_pass_HLT_xe70_tclcw,
+  kVar_eff_study_dPhijj_allmet_pass_HLT_xe70_tclcw,
+  kVar_eff_study_mjj_met130,
+  kVar_eff_study_dPhijj_met130,
+  kVar_eff_study_mjj_met130_pass_HLT_xe70,
+  kVar_eff_study_dPhijj_met130_pass_HLT_xe70,
+  kVar_eff_study_mjj_met130_pass_HLT_xe70_tclcw,
+  kVar_eff_study_dPhijj_met130_pass_HLT_xe70_tclcw,
+  kVar_eff_study_mjj_met150,
+  kVar_eff_study_dPhijj_met150,
+  kVar_eff_study_mjj_met150_pass_HLT_xe70,
+  kVar_eff_study_dPhijj_met150_pass_HLT_xe70,
+  kVar_eff_study_mjj_met150_pass_HLT_xe70_tclcw,
+  kVar_eff_study_dPhijj_met150_pass_HLT_xe70_tclcw,
+  kVar_eff_study_mjj_met200,
+  kVar_eff_study_dPhijj_met200,
+  kVar_eff_study_mjj_met200_pass_HLT_xe70,
+  kVar_eff_study_dPhijj_met200_pass_HLT_xe70,
+  kVar_eff_study_mjj_met200_pass_HLT_xe70_tclcw,
+  kVar_eff_study_dPhijj_met200_pass_HLT_xe70_tclcw,
+  kVar_multijet_study_mll_all_lep,
+  kVar_multijet_study_met_emulmet_all_lep,
+  kVar_multijet_study_mll_os_lep,
+  kVar_multijet_study_met_emulmet_os_lep,
+  kVar_multijet_study_mll_ss_lep,
+  kVar_multijet_study_met_emulmet_ss_lep,
+  kVar_multijet_study_mjj_all_lep,
+  kVar_multijet_study_dPhijj_all_lep,
+  kVar_multijet_study_mjj_os_lep,
+  kVar_multijet_study_dPhijj_os_lep,
+  kVar_multijet_study_mjj_ss_lep,
+  kVar_multijet_study_dPhijj_ss_lep,
+  kVar_qcd_method2_nominal_cut_met150_200_mll,
+  kVar_qcd_method2_nominal_cut_met200_300_mll,
+  kVar_qcd_method2_nominal_cut_met300_500_mll,
+  kVar_qcd_method2_nominal_cut_met500_inf_mll,
+  kVar_qcd_method2_met150_200_count_mll,
+  kVar_qcd_method2_met200_300_count_mll,
+  kVar_qcd_method2_met300_500_count_mll,
+  kVar_qcd_method2_met500_inf_count_mll,
+  kVar_qcd_method2_case1_cut_met150_200_mll,
+  kVar_qcd_method2_case1_cut_met200_300_mll,
+  kVar_qcd_method2_case1_cut_met300_500_mll,
+  kVar_qcd_method2_case1_cut_met500_inf_mll,
+  kVar_qcd_method2_case2_cut_met150_200_mll,
+  kVar_qcd_method2_case2_cut_met200_300_mll,
+  kVar_qcd_method2_case2_cut_met300_500_mll,
+  kVar_qcd_method2_case2_cut_met500_inf_mll,
+  kVar_qcd_method2_case3_cut_met150_200_mll,
+  kVar_qcd_method2_case3_cut_met200_300_mll,
+  kVar_qcd_method2_case3_cut_met300_500_mll,
+  kVar_qcd_method2_case3_cut_met500_inf_mll,
+  kVar_qcd_method2_nominal_cut_met,
+  kVar_NTauBefore,
+  kVar_NEleBefore,
+  kVar_NMuBefore,
+  kVar_NMuZBefore,
+  kVar_NJetBefore,
+  kVar_NTauAfter,
+  kVar_NEleAfter,
+  kVar_NMuAfter,
+  kVar_NMuZAfter,
+  kVar_NJetAfter,
+  kVar_met_cst,
+  kVar_met_emulmet_cst,
+  kNumHistVariables
+};
+
+/// Event weight used by a fill, needed to fill the weight-only systematics
+/// from the nominal pass
+enum HistWeight {
+  kWeightUnit,     /// constant weight, identical for all variations
+  kWeightEvent,    /// mcEventWeight (MC and pileup weight)
+  kWeightMuon,     /// mcEventWeight x muon scale factors
+  kWeightElectron, /// mcEventWeight x electron scale factors
+  kNumHistWeights
+};
+
+/// Integer-indexed lookup of the 1D histograms booked in initialize().
+/// Histograms are registered once per (channel, region, variable, systematic)
+/// and resolved in execute() with plain array indexing instead of building
+/// and hashing the histogram name on every Fill().
+class HistRegistry
+{
+
+public:
+	HistRegistry();
+	~HistRegistry();
+
+	/// Output name of a histogram, identical to the historical string keys
+	static std::string Name(int channel, int region, int variable, const std::string& sysName);
+
+	/// Index of a systematic on the registry axis (added if not known yet)
+	int AddSystematic(const std::string& sysName);
+
+	/// Register a booked histogram. Call Freeze() once booking is done.
+	void Register(int channel, int region, int variable, int sys, TH1* hist);
+
+	/// Build the flat (slot x systematic) lookup table
+	void Freeze();
+
+	/// Histogram for the given coordinates, 0 if it was never booked
+	inline TH1* Get(int channel, int region, int variable, int sys) const {
+		if (sys < 0) return 0;
+		int slot = m_slot[(channel*kNumHistRegions + region)*kNumHistVariables + variable];
+		if (slot < 0) return 0;
+		return m_hists[slot*m_nSys + sys];
+	}
+
+	/// Weight-only systematics (registry indices) filled together with the nominal
+	void SetWeightSystematics(const std::vector<int>& sys);
+	inline unsigned int NumWeightSystematics() const { return m_weightSys.size(); }
+
+	/// Event weight of the i-th weight-only systematic for the given HistWeight
+	inline void SetWeightVariation(int weight, unsigned int i, double w) { m_weightVar[weight][i] = w; }
+	inline double WeightVariation(int weight, unsigned int i) const { return m_weightVar[weight][i]; }
+
+	/// Fill the weight-only systematics along with each Fill() (nominal pass only)
+	inline void FillWeightSystematics(bool fill) { m_fillWeightSys = fill && !m_weightSys.empty(); }
+	inline bool FillingWeightSystematics() const { return m_fillWeightSys; }
+
+	/// Number of Fill() calls so far
+	inline unsigned long long NumFills() const { return m_numFills; }
+
+	inline void Fill(int channel, int region, int variable, int sys, double x, double w, int weight) {
+		m_numFills++;
+		TH1* h = Get(channel, region, variable, sys);
+		if (h) h->Fill(x, w);
+		if (!m_fillWeightSys) return;
+		for (unsigned int i = 0; i < m_weightSys.size(); i++) {
+			TH1* hs = Get(channel, region, variable, m_weightSys[i]);
+			if (hs) hs->Fill(x, weight == kWeightUnit ? w : m_weightVar[weight][i]);
+		}
+	}
+
+private:
+
+	struct Booking {
+		int slot;
+		int sys;
+		TH1* hist;
+	};
+
+	/// (channel, region, variable) -> slot, -1 if not booked
+	std::vector<int> m_slot; //!
+
+	/// flat table of booked histograms, index slot*m_nSys + sys
+	std::vector<TH1*> m_hists; //!
+
+	/// histograms registered before Freeze()
+	std::vector<Booking> m_bookings; //!
+
+	/// systematic name -> index on the registry axis
+	std::map<std::string, int> m_sysIndex; //!
+
+	int m_nSlots; //!
+	int m_nSys; //!
+
+	/// weight-only systematics and their per-event weights
+	std::vector<int> m_weightSys; //!
+	std::vector<double> m_weightVar[kNumHistWeights]; //!
+	bool m_fillWeightSys; //!
+
+	unsigned long long m_numFills; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(HistRegistry, 1);
+
+};
+
+#endif
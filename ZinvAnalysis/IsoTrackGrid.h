@@ -0,0 +1,66 @@
+#ifndef IsoTrackGrid_H
+#define IsoTrackGrid_H
+
+#include <Rtypes.h>
+#include <vector>
+
+/// Eta-phi grid of the quality tracks of an event, used by the isolated-track
+/// veto. Tracks are binned into cells at least as wide as the isolation cone,
+/// so the tracks within dR of a probe are always in the 3x3 cells around it
+/// and neighbour counting is near-linear instead of a loop over all pairs.
+class IsoTrackGrid
+{
+
+public:
+	IsoTrackGrid(float coneSize = 0.4, float etaMax = 2.5);
+	~IsoTrackGrid();
+
+	/// Remove all tracks (call once per event)
+	void Clear();
+
+	/// Add a track passing the quality cuts, returns its index
+	unsigned int Add(float pt, float eta, float phi);
+
+	/// Bin the added tracks into the grid. Call before NumNeighbours().
+	void Build();
+
+	/// Number of tracks with pt >= ptMin within the cone around (eta, phi),
+	/// not counting the track with index skip (-1: count all)
+	int NumNeighbours(float eta, float phi, float ptMin, int skip = -1) const;
+
+	inline unsigned int Size() const { return m_pt.size(); }
+	inline float Pt(unsigned int i) const { return m_pt[i]; }
+	inline float Eta(unsigned int i) const { return m_eta[i]; }
+	inline float Phi(unsigned int i) const { return m_phi[i]; }
+
+private:
+
+	inline int EtaBin(float eta) const {
+		int bin = int((eta + m_etaMax) / m_etaWidth);
+		return bin < 0 ? 0 : (bin >= m_nEta ? m_nEta - 1 : bin);
+	}
+	int PhiBin(float phi) const;
+
+	float m_coneSize; //!
+	float m_etaMax; //!
+	float m_etaWidth; //!
+	float m_phiWidth; //!
+	int m_nEta; //!
+	int m_nPhi; //!
+
+	/// tracks (pt in GeV)
+	std::vector<float> m_pt; //!
+	std::vector<float> m_eta; //!
+	std::vector<float> m_phi; //!
+
+	/// track indices sorted by cell, cell c holds [m_cellStart[c], m_cellStart[c+1])
+	std::vector<unsigned int> m_cellStart; //!
+	std::vector<unsigned int> m_cellTracks; //!
+	std::vector<int> m_trackCell; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(IsoTrackGrid, 1);
+
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef JetTopology_H
+#define JetTopology_H
+
+#include <Rtypes.h>
+
+#include <ZinvAnalysis/ParticleStore.h>
+
+/// MET hypotheses the jets are compared with
+enum METHypothesis {
+  kMetZnunu,  /// real MET
+  kMetZmumu,  /// emulated MET (muons invisible)
+  kMetWmunu,
+  kMetZee,
+  kMetWenu,
+  kNumMetHypotheses
+};
+
+/// Number of leading jets entering the dPhi(jet_i,MET) cut
+const unsigned int kNumDPhiJets = 4;
+
+/// Jet topology of the event (MeV), filled by JetTopology::Compute()
+struct JetTopologyResult
+{
+  unsigned int nJets;
+  float mjj;            // two leading jets
+  float dPhijj;
+  float dRjj;
+  float ht;             // scalar sum of the jet pt
+  bool centralJet;      // jet other than the two leading ones in the rapidity gap (CJV)
+  bool subleadingJet;   // subleading jet above the SM1 veto threshold
+  float dPhiJetMet[kNumMetHypotheses][kNumDPhiJets]; // leading jets, 0 if not active
+  float dPhiMinJetMet[kNumMetHypotheses];            // 10 if not active
+  bool passDPhiJetMet[kNumMetHypotheses];
+};
+
+/// Jet topology of the good jets. Compute() reads the jet arrays of the
+/// ParticleStore and derives everything the channel selections need in a
+/// single pass, so the selections no longer walk m_goodJet for each quantity.
+class JetTopology
+{
+
+public:
+	JetTopology();
+	~JetTopology();
+
+	/// CJV jet threshold and rapidity range, SM1 subleading jet veto threshold,
+	/// jet threshold, rapidity range and dPhi cut of the dPhi(jet_i,MET) cut
+	void SetCuts(float cjvPtCut, float cjvRapCut, float sm1VetoPtCut,
+			float dPhiJetPtCut, float dPhiJetRapCut, float dPhiCut);
+
+	/// jets: good jets in decreasing pt order,
+	/// metPhi: phi of the kNumMetHypotheses MET hypotheses,
+	/// activeMask: bit (1 << METHypothesis) set for the hypotheses to compute
+	void Compute(const ParticleStore& jets, const float* metPhi, unsigned int activeMask,
+			JetTopologyResult& result) const;
+
+private:
+
+	float m_cjvPtCut; //!
+	float m_cjvRapCut; //!
+	float m_sm1VetoPtCut; //!
+	float m_dPhiJetPtCut; //!
+	float m_dPhiJetRapCut; //!
+	float m_dPhiCut; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(JetTopology, 1);
+
+};
+
+#endif
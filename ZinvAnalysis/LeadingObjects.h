@@ -0,0 +1,58 @@
+#ifndef LeadingObjects_H
+#define LeadingObjects_H
+
+#include <Rtypes.h>
+#include <vector>
+
+#include "xAODBase/IParticle.h"
+
+/// Collects the objects of a view container while it is being filled and
+/// keeps the leading ones in descending pt, with the pt read once per object.
+/// Fill() writes the leading objects first, in pt order, followed by the
+/// others, like a partial_sort of the view. The others are in no particular
+/// order: an object is appended to them when it is added below the leading
+/// ones or when a harder object displaces it from them.
+class LeadingObjects
+{
+
+public:
+	/// numLeading objects are kept ordered; kAllObjects orders the whole collection
+	LeadingObjects(unsigned int numLeading = 2);
+	~LeadingObjects();
+
+	static const unsigned int kAllObjects = ~0u;
+
+	/// Remove all objects
+	void Clear();
+
+	/// Add an object, placed among the leading ones if its pt is high enough
+	void Add(xAOD::IParticle* particle);
+
+	inline unsigned int Size() const { return m_leading.size() + m_others.size(); }
+
+	/// Append the objects to a view container of their type
+	template <class T>
+	void Fill(T& view) const;
+
+private:
+
+	unsigned int m_numLeading; //!
+	/// leading objects in descending pt, and their pt
+	std::vector<xAOD::IParticle*> m_leading; //!
+	std::vector<float> m_leadingPt; //!
+	std::vector<xAOD::IParticle*> m_others; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(LeadingObjects, 1);
+
+};
+
+
+template <class T>
+void LeadingObjects::Fill(T& view) const {
+  typedef typename T::base_value_type Object;
+  for (unsigned int i = 0; i < m_leading.size(); i++) view.push_back(static_cast<Object*>(m_leading[i]));
+  for (unsigned int i = 0; i < m_others.size(); i++) view.push_back(static_cast<Object*>(m_others[i]));
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef ObjectFlags_H
+#define ObjectFlags_H
+
+#include <Rtypes.h>
+#include <vector>
+
+/// Selection flags of the objects of a collection
+enum ObjectFlag {
+  kObjBaseline,     /// baseline (loose) object
+  kObjSignal,       /// good object
+  kObjSignalForZ,   /// non-isolated muon for Z->mumu
+  kObjBad,          /// bad jet (loose cleaning)
+  kObjSelected,     /// input of the overlap removal
+  kNumObjectFlags
+};
+
+/// Selection flags and scale factors of a collection, kept in bit arrays
+/// indexed by the object index (a shallow copy keeps the index of its input)
+/// instead of aux-store decorations. Only the overlap removal input is
+/// written to the objects, by the caller, as ORUtils needs it.
+class ObjectFlags
+{
+
+public:
+	ObjectFlags();
+	~ObjectFlags();
+
+	/// Size to the collection, all flags false and scale factors 1
+	void Reset(unsigned int size);
+
+	/// Clear the flags of an object
+	inline void Clear(unsigned int index) {
+		const unsigned long long mask = ~(1ULL << (index & 63));
+		for (unsigned int f = 0; f < kNumObjectFlags; f++) m_bits[f][index >> 6] &= mask;
+	}
+
+	inline bool Get(unsigned int flag, unsigned int index) const {
+		return (m_bits[flag][index >> 6] >> (index & 63)) & 1ULL;
+	}
+
+	inline void Set(unsigned int flag, unsigned int index, bool value = true) {
+		if (value) m_bits[flag][index >> 6] |= 1ULL << (index & 63);
+		else m_bits[flag][index >> 6] &= ~(1ULL << (index & 63));
+	}
+
+	inline double ScaleFactor(unsigned int index) const { return m_scaleFactor[index]; }
+	inline void SetScaleFactor(unsigned int index, double sf) { m_scaleFactor[index] = sf; }
+
+	inline unsigned int Size() const { return m_scaleFactor.size(); }
+
+private:
+
+	/// one bit per object for each flag
+	std::vector<unsigned long long> m_bits[kNumObjectFlags]; //!
+	std::vector<double> m_scaleFactor; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(ObjectFlags, 1);
+
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ParticleStore_H
+#define ParticleStore_H
+
+#include <Rtypes.h>
+#include <vector>
+
+/// Object flags
+enum ParticleFlag {
+  kFlagBTagged = 1 << 0  /// jet passing the b-tagging selection
+};
+
+/// Kinematics of a selected object collection (MeV) in contiguous arrays,
+/// in the order of the view container it was taken from. Filled once per
+/// systematic after the overlap removal so the selections and histogram
+/// fills do not go through the xAOD aux store again.
+class ParticleStore
+{
+
+public:
+	ParticleStore();
+	~ParticleStore();
+
+	/// Remove all objects
+	void Clear();
+
+	/// Add an object; index is the index in its xAOD container
+	void Add(float pt, float eta, float phi, float m, float rapidity,
+			float charge, unsigned int index, unsigned int flags = 0);
+
+	inline unsigned int Size() const { return m_pt.size(); }
+	inline float Pt(unsigned int i) const { return m_pt[i]; }
+	inline float Eta(unsigned int i) const { return m_eta[i]; }
+	inline float Phi(unsigned int i) const { return m_phi[i]; }
+	inline float M(unsigned int i) const { return m_m[i]; }
+	inline float Rapidity(unsigned int i) const { return m_rapidity[i]; }
+	inline float Charge(unsigned int i) const { return m_charge[i]; }
+	inline unsigned int Index(unsigned int i) const { return m_index[i]; }
+	inline bool HasFlag(unsigned int i, unsigned int flag) const { return m_flags[i] & flag; }
+
+	/// Phi of all objects, for the batch kernels of DeltaKernels.h
+	inline const float* PhiArray() const { return m_phi.data(); }
+
+	/// Number of objects with the given flag
+	unsigned int CountFlag(unsigned int flag) const;
+
+	/// Invariant mass of the objects i and j
+	float Mass(unsigned int i, unsigned int j) const;
+
+private:
+
+	std::vector<float> m_pt; //!
+	std::vector<float> m_eta; //!
+	std::vector<float> m_phi; //!
+	std::vector<float> m_m; //!
+	std::vector<float> m_rapidity; //!
+	std::vector<float> m_charge; //!
+	std::vector<unsigned int> m_index; //!
+	std::vector<unsigned int> m_flags; //!
+
+	/// this is needed to distribute the algorithm to the workers
+	ClassDef(ParticleStore, 1);
+
+};
+
+#endif
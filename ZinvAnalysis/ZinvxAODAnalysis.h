@@ -26,6 +26,7 @@
 #include "xAODEgamma/PhotonContainer.h"
 #include "xAODTau/TauJet.h"
 #include "xAODTau/TauJetContainer.h"
+#include "xAODEventInfo/EventInfo.h"
 #include "xAODTracking/VertexContainer.h"
 #include "xAODTracking/TrackParticleContainer.h"
 #include "xAODTracking/TrackParticlexAODHelpers.h"
@@ -105,10 +106,44 @@
 
 // Systematics
 #include "PATInterfaces/SystematicRegistry.h"
+#include "PATInterfaces/ISystematicsTool.h"
 
 // Cut Flow
 #include <ZinvAnalysis/BitsetCutflow.h>
 
+// Histograms
+#include <ZinvAnalysis/HistRegistry.h>
+
+// Isolated track veto
+#include <ZinvAnalysis/IsoTrackGrid.h>
+
+// Batch deltaPhi / deltaR
+#include <ZinvAnalysis/DeltaKernels.h>
+
+// Jet topology
+#include <ZinvAnalysis/JetTopology.h>
+
+// Selected objects in contiguous arrays
+#include <ZinvAnalysis/ParticleStore.h>
+
+// Four-vector for the invariant and transverse masses
+#include <ZinvAnalysis/FourVector.h>
+
+// Object decisions reused across systematics
+#include <ZinvAnalysis/DecisionCache.h>
+
+// Object selection cut chains
+#include <ZinvAnalysis/CutChain.h>
+
+// Containers of execute()
+#include <ZinvAnalysis/EventArena.h>
+
+// Selection flags of the objects
+#include <ZinvAnalysis/ObjectFlags.h>
+
+// Leading objects of the good collections
+#include <ZinvAnalysis/LeadingObjects.h>
+
 // Root includes
 #include <TH1.h>
 #include <TH2.h>
@@ -123,6 +158,75 @@
 #include "TrigDecisionTool/TrigDecisionTool.h"
 
 
+// Active systematic, resolved once in initialize()
+struct ActiveSystematic
+{
+  unsigned int index;        // position in m_sysList
+  std::string name;          // histogram suffix
+  bool isNominal;
+  int hist;                  // HistRegistry systematic index
+  unsigned int dependencies; // SysDependency mask
+  unsigned int tools;        // bit mask of the affected m_systematicsTools
+};
+
+
+// CP tool taking part in the systematics loop
+struct SystematicsTool
+{
+  CP::ISystematicsTool* tool;
+  std::string name;
+  unsigned int dependencies; // SysDependency mask of the systematics affecting it
+};
+
+
+// Inner detector tracks of the event, extracted once per event (pt in GeV,
+// z0 relative to the primary vertex, chi2 per degree of freedom)
+struct TrackSummary
+{
+  std::vector<float> pt;
+  std::vector<float> eta;
+  std::vector<float> phi;
+  std::vector<float> d0;
+  std::vector<float> z0;
+  std::vector<float> chi2;
+  std::vector<int> nHits;    // pixel + SCT hits
+  std::vector<char> pass;    // track quality cut
+
+  void Clear() {
+    pt.clear(); eta.clear(); phi.clear(); d0.clear(); z0.clear(); chi2.clear(); nHits.clear(); pass.clear();
+  }
+  unsigned int Size() const { return pt.size(); }
+};
+
+// Event quantities used by the object selection, filled once per event
+struct EventContext
+{
+  const xAOD::EventInfo* eventInfo;
+  const xAOD::Vertex* primVertex;
+  float primVertexZ;
+  float beamPosSigmaX;
+  float beamPosSigmaY;
+  float beamPosSigmaXY;
+  float averageInteractionsPerCrossing; // uncorrected
+  unsigned int runNumber;
+  unsigned long long eventNumber;
+  bool isData;
+
+  void Fill(const xAOD::EventInfo* info, const xAOD::Vertex* vtx, bool data) {
+    eventInfo = info;
+    primVertex = vtx;
+    primVertexZ = vtx->z();
+    beamPosSigmaX = info->beamPosSigmaX();
+    beamPosSigmaY = info->beamPosSigmaY();
+    beamPosSigmaXY = info->beamPosSigmaXY();
+    averageInteractionsPerCrossing = info->averageInteractionsPerCrossing();
+    runNumber = info->runNumber();
+    eventNumber = info->eventNumber();
+    isData = data;
+  }
+};
+
+
 class ZinvxAODAnalysis : public EL::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -130,6 +234,13 @@ class ZinvxAODAnalysis : public EL::Algorithm
   public:
     // float cutValue;
 
+    // Systematics split over parallel jobs on the same input: this job runs
+    // slice sysSliceIndex of sysSliceCount. Slice 0 also runs the nominal,
+    // the weight-only systematics, the cutflow and the bookkeeping, so the
+    // slice outputs can simply be merged with hadd.
+    int sysSliceIndex;
+    int sysSliceCount;
+
 
 
     // variables that don't get filled at submission time should be
@@ -154,10 +265,22 @@ class ZinvxAODAnalysis : public EL::Algorithm
     bool m_isZee; //!
     bool m_isWenu; //!
  
-    std::string h_channel; //!
+    int m_histChannel; //!
 
     // Enable Systematics
     bool m_doSys; //!
+    bool m_doWeightSysFastPath; //!
+    bool m_doSysEnvelope; //!
+    bool m_validateSysEnvelope; //!
+
+    // Rebuild the emulated MET hypotheses taken from the real MET terms, and compare
+    bool m_validateEmulatedMET; //!
+    long long m_numEmulMETCompared; //!
+    long long m_numEmulMETMismatches; //!
+
+
+    // Reorder the object selection cuts by cost and rejection after a warm-up
+    bool m_doAdaptiveCutOrder; //!
 
     // Cutflow
     bool m_useBitsetCutflow; //!
@@ -183,6 +306,9 @@ class ZinvxAODAnalysis : public EL::Algorithm
     float m_diJetRapCut; //!
     float m_CJVptCut; //!
     float m_metCut; //!
+    float m_envelopeJetShift; //!
+    float m_envelopeLeptonShift; //!
+    float m_envelopeJetMigrationPt; //!
     float m_mjjCut; //!
     float m_LeadLepPtCut; //!
     float m_SubLeadLepPtCut; //!
@@ -223,6 +349,56 @@ class ZinvxAODAnalysis : public EL::Algorithm
 
     std::map<std::string, TH1*> hMap1D; //!
 
+    // Integer handles for the histograms in hMap1D
+    HistRegistry* m_histRegistry; //!
+
+    // Isolated track veto (quality tracks of the event on an eta-phi grid)
+    bool m_doIsoTrackVeto; //!
+    TrackSummary m_trackSummary; //!
+
+    // Event quantities passed to the object selection
+    EventContext m_eventContext; //!
+    IsoTrackGrid* m_isoTrackGrid; //!
+
+    // Object decisions of the event (ID, quality, cleaning, b-tagging)
+    DecisionCache* m_decisionCache; //!
+
+    // Per-event and per-systematic containers of execute()
+    EventArena* m_eventArena; //!
+
+    // Selection flags of the arena shallow copies, and of the copies used by the current pass
+    std::vector<ObjectFlags> m_copyFlags; //!
+    ObjectFlags* m_muonFlags; //!
+    ObjectFlags* m_elecFlags; //!
+    ObjectFlags* m_photFlags; //!
+    ObjectFlags* m_tauFlags; //!
+    ObjectFlags* m_jetFlags; //!
+
+    // Good collections ordered in pt while they are filled
+    std::vector<LeadingObjects> m_leadingObjects; //!
+
+    // Cut chains of passMuonVBF, passElectronVBF, passPhotonVBF and passTauVBF
+    CutChain* m_muonCuts; //!
+    CutChain* m_elecCuts; //!
+    CutChain* m_photCuts; //!
+    CutChain* m_tauCuts; //!
+
+    // Good jets of the systematic being processed (mjj, CJV, dPhi(jet_i,MET), ...)
+    JetTopology* m_jetTopology; //!
+
+    // Snapshot of the selected objects after the overlap removal (same order as the views)
+    ParticleStore m_jetStore; //!
+    ParticleStore m_muonStore; //!
+    ParticleStore m_muonForZStore; //!
+    ParticleStore m_baselineMuonStore; //!
+    ParticleStore m_electronStore; //!
+    ParticleStore m_baselineElectronStore; //!
+    ParticleStore m_tauStore; //!
+    ParticleStore m_photonStore; //!
+
+    // registry systematic index of the systematic being processed
+    int m_histSys; //!
+
 
 
     // trigger tools member variables
@@ -312,6 +488,34 @@ class ZinvxAODAnalysis : public EL::Algorithm
 
     // list of systematics
     std::vector<CP::SystematicSet> m_sysList; //!
+    // Stages and weights a systematic can affect
+    enum SysDependency {
+      kSysMuons          = 1 << 0,
+      kSysElectrons      = 1 << 1,
+      kSysPhotons        = 1 << 2,
+      kSysTaus           = 1 << 3,
+      kSysJets           = 1 << 4,
+      kSysMETSoftTerm    = 1 << 5,
+      kSysMuonWeight     = 1 << 6,
+      kSysElectronWeight = 1 << 7,
+      kSysTauWeight      = 1 << 8,
+      kSysPileupWeight   = 1 << 9,
+      kSysObjects = kSysMuons | kSysElectrons | kSysPhotons | kSysTaus | kSysJets
+    };
+    // CP tools reconfigured per systematic, and the ones currently set to a variation
+    std::vector<SystematicsTool> m_systematicsTools; //!
+    unsigned int m_variedTools; //!
+    long long m_numToolSwitches; //!
+    long long m_numToolSwitchesAll; //!
+    // Systematic passes skipped by the envelope, and wrongly skipped ones (validation)
+    long long m_numEnvelopeSkipped; //!
+    long long m_numEnvelopeFailures; //!
+    // Active systematics running a selection pass
+    std::vector<ActiveSystematic> m_selectionSystematics; //!
+    // Weight-only systematics filled from the nominal pass, in HistRegistry order
+    std::vector<ActiveSystematic> m_weightSystematics; //!
+    // Soft term variations of the selection passes, and the nominal (envelope)
+    std::vector<CP::SystematicSet> m_softTermSystematics; //!
 
     // Cutflow
     BitsetCutflow* m_BitsetCutflow; //!
@@ -334,39 +538,37 @@ class ZinvxAODAnalysis : public EL::Algorithm
 
     // Custom made functions
 
-    virtual EL::StatusCode addHist(std::map<std::string, TH1*> &hMap, std::string tag,
+    virtual EL::StatusCode addHist(std::map<std::string, TH1*> &hMap,
+        int channel, int region, int variable, const std::string &sysName,
         int bins, double min, double max);
 
-    virtual EL::StatusCode addHist(std::map<std::string, TH1*> &hMap, std::string tag,
+    virtual EL::StatusCode addHist(std::map<std::string, TH1*> &hMap,
+        int channel, int region, int variable, const std::string &sysName,
         int bins, Float_t binArray[]);
 
     virtual EL::StatusCode passMuonSelection(xAOD::Muon& mu,
-        const xAOD::EventInfo* eventInfo,
-        const xAOD::Vertex* primVertex);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passMuonVBF(xAOD::Muon& mu,
-        const xAOD::EventInfo* eventInfo,
-        const xAOD::Vertex* primVertex);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passElectronSelection(xAOD::Electron& elec,
-        const xAOD::EventInfo* eventInfo,
-        const xAOD::Vertex* primVertex);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passElectronVBF(xAOD::Electron& elec,
-        const xAOD::EventInfo* eventInfo,
-        const xAOD::Vertex* primVertex);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passPhotonSelection(xAOD::Photon& phot,
-        const xAOD::EventInfo* eventInfo);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passTauSelection(xAOD::TauJet& tau,
-        const xAOD::EventInfo* eventInfo);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passPhotonVBF(xAOD::Photon& phot,
-        const xAOD::EventInfo* eventInfo);
+        const EventContext& ctx);
 
     virtual EL::StatusCode passTauVBF(xAOD::TauJet& tau,
-        const xAOD::EventInfo* eventInfo);
+        const EventContext& ctx);
 
     bool IsBadJet(xAOD::Jet& jet);
 
@@ -384,22 +586,42 @@ class ZinvxAODAnalysis : public EL::Algorithm
     float GetTotalElectronSF(xAOD::ElectronContainer& electrons,
         bool recoSF, bool idSF, bool isoSF, bool trigSF);
 
-    int NumIsoTracks(const xAOD::TrackParticleContainer* inTracks,
-        const xAOD::Vertex* primVertex, float Pt_Low, float Pt_High);
+    void ApplyMuonSFSystematic(const CP::SystematicSet& sys);
+
+    void ApplyElectronSFSystematic(const CP::SystematicSet& sys);
+
+    void FillTrackSummary(const xAOD::TrackParticleContainer* inTracks,
+        const xAOD::Vertex* primVertex, float Pt_Low);
 
-    int NumMuonIsoTrack(xAOD::MuonContainer* muons, const xAOD::TrackParticleContainer* inTracks,
-        const xAOD::Vertex* primVertex, float Pt_Low, float Pt_High);
+    void FillIsoTrackGrid();
 
-    int NumElecIsoTrack(xAOD::ElectronContainer* electrons, const xAOD::TrackParticleContainer* inTracks,
-        const xAOD::Vertex* primVertex, float Pt_Low, float Pt_High);
+    int NumIsoTracks(float Pt_Low, float Pt_High);
+
+    int NumMuonIsoTrack(xAOD::MuonContainer* muons, float Pt_Low, float Pt_High);
+
+    int NumElecIsoTrack(xAOD::ElectronContainer* electrons, float Pt_Low, float Pt_High);
+
+    void RebuildEmulatedMET(xAOD::MissingETContainer* met,
+        const xAOD::MissingETContainer* metCore, const xAOD::MissingETAssociationMap* metMap,
+        const std::string& softTerm, const xAOD::ElectronContainer* electrons,
+        const xAOD::TauJetContainer* taus, const xAOD::MuonContainer* muons,
+        const xAOD::IParticleContainer* invisibles, const xAOD::JetContainer* jets,
+        float& met_final, float& met_phi, float& met_CST);
+
+    bool SoftTermEnvelopeShift(xAOD::MissingET* softTrkmet, const CP::SystematicSet& currentSys,
+        float& maxShift);
+
+    void CompareEmulatedMET(const char* hypothesis, float met, float met_phi,
+        float rebuiltMET, float rebuiltMET_phi);
 
     float deltaPhi(float phi1, float phi2);
 
     float deltaR(float eta1, float eta2, float phi1, float phi2);
 
 
+
     // this is needed to distribute the algorithm to the workers
-    ClassDef(ZinvxAODAnalysis, 1);
+    ClassDef(ZinvxAODAnalysis, 2);
 };
 
 #endif
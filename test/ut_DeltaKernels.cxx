@@ -0,0 +1,90 @@
+//
+//  Unit test of the batch deltaPhi/deltaR kernels of DeltaKernels.h: the batch
+//  versions (vectorised when the compiler enables it) must agree with the scalar
+//  definition used by ZinvxAODAnalysis::deltaPhi/deltaR.
+//
+//============================================================================================================
+
+#include <ZinvAnalysis/DeltaKernels.h>
+
+#include <TError.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+  // Same definition as ZinvxAODAnalysis::deltaPhi and deltaR
+  float refDeltaPhi(float phi1, float phi2) {
+    float dPhi = std::fabs(phi1 - phi2);
+    if (dPhi > TMath::Pi()) dPhi = TMath::TwoPi() - dPhi;
+    return dPhi;
+  }
+
+  float refDeltaR(float eta1, float eta2, float phi1, float phi2) {
+    float dEta = eta1 - eta2;
+    float dPhi = refDeltaPhi(phi1, phi2);
+    return TMath::Sqrt(dEta*dEta + dPhi*dPhi);
+  }
+
+  const float tolerance = 1e-5;
+
+  // Compare the batch kernels with the reference on n objects
+  bool check(const std::vector<float>& eta, const std::vector<float>& phi) {
+    const unsigned int n = eta.size();
+    std::vector<float> dPhi(n), dPhiScalar(n), dR(n), dRScalar(n), dRPairs(n * n), dRPairsScalar(n * n);
+
+    DeltaPhiOneToMany(phi[0], &phi[0], &dPhi[0], n);
+    DeltaPhiOneToManyScalar(phi[0], &phi[0], &dPhiScalar[0], n);
+    DeltaROneToMany(eta[0], phi[0], &eta[0], &phi[0], &dR[0], n);
+    DeltaROneToManyScalar(eta[0], phi[0], &eta[0], &phi[0], &dRScalar[0], n);
+    DeltaRPairwise(&eta[0], &phi[0], n, &eta[0], &phi[0], n, &dRPairs[0]);
+    DeltaRPairwiseScalar(&eta[0], &phi[0], n, &eta[0], &phi[0], n, &dRPairsScalar[0]);
+
+    float maxDiffPhi = 0., maxDiffR = 0., maxDiffPairs = 0.;
+    for (unsigned int i = 0; i < n; i++) {
+      const float refPhi = refDeltaPhi(phi[i], phi[0]);
+      const float refR = refDeltaR(eta[i], eta[0], phi[i], phi[0]);
+      maxDiffPhi = std::max(maxDiffPhi, std::max(std::fabs(dPhi[i] - refPhi), std::fabs(dPhiScalar[i] - refPhi)));
+      maxDiffR = std::max(maxDiffR, std::max(std::fabs(dR[i] - refR), std::fabs(dRScalar[i] - refR)));
+      for (unsigned int j = 0; j < n; j++) {
+        const float refPair = refDeltaR(eta[i], eta[j], phi[i], phi[j]);
+        maxDiffPairs = std::max(maxDiffPairs, std::max(std::fabs(dRPairs[i*n + j] - refPair),
+              std::fabs(dRPairsScalar[i*n + j] - refPair)));
+      }
+    }
+
+    if (maxDiffPhi < tolerance && maxDiffR < tolerance && maxDiffPairs < tolerance) return true;
+    Error("ut_DeltaKernels", "%u objects: max difference deltaPhi %g, deltaR %g, pairwise deltaR %g",
+        n, maxDiffPhi, maxDiffR, maxDiffPairs);
+    return false;
+  }
+
+}
+
+int main() {
+
+  bool ok = true;
+
+  // Random objects, with sizes that exercise the vector loops and their remainders
+  TRandom3 random(4357);
+  for (unsigned int n = 1; n <= 33; n++) {
+    std::vector<float> eta(n), phi(n);
+    for (unsigned int i = 0; i < n; i++) {
+      eta[i] = random.Uniform(-4.5, 4.5);
+      phi[i] = random.Uniform(-TMath::Pi(), TMath::Pi());
+    }
+    ok = check(eta, phi) && ok;
+  }
+
+  // Objects at the phi boundaries and back to back
+  const float pi = TMath::Pi();
+  std::vector<float> eta = {0., 0., 1., -1., 2.5, -2.5, 0., 4.5, -4.5};
+  std::vector<float> phi = {pi, -pi, 0., pi / 2, -pi / 2, 3.14159f, -3.14159f, 1e-7f, -1e-7f};
+  ok = check(eta, phi) && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+//
+//  Unit test of FourVector: the pair mass, pt, rapidity and deltaR of random jet
+//  pairs must agree with TLorentzVector, as must the PtEtaPhiE construction of
+//  the dressed truth leptons.
+//
+//============================================================================================================
+
+#include <ZinvAnalysis/FourVector.h>
+
+#include <TError.h>
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+#include <algorithm>
+#include <cmath>
+
+int main() {
+
+  const unsigned int nPairs = 100000;
+  const double tolerance = 1e-9; // relative, absolute for deltaR
+
+  TRandom3 random(4357);
+  double maxDiffM = 0., maxDiffPt = 0., maxDiffY = 0., maxDiffR = 0., maxDiffE = 0.;
+  for (unsigned int i = 0; i < nPairs; i++) {
+    const double pt1 = random.Uniform(20000., 1000000.), pt2 = random.Uniform(20000., 1000000.);
+    const double eta1 = random.Uniform(-4.5, 4.5), eta2 = random.Uniform(-4.5, 4.5);
+    const double phi1 = random.Uniform(-TMath::Pi(), TMath::Pi()), phi2 = random.Uniform(-TMath::Pi(), TMath::Pi());
+    const double m1 = random.Uniform(0., 50000.), m2 = random.Uniform(0., 50000.);
+
+    TLorentzVector tlv1, tlv2;
+    tlv1.SetPtEtaPhiM(pt1, eta1, phi1, m1);
+    tlv2.SetPtEtaPhiM(pt2, eta2, phi2, m2);
+    FourVector fv1 = FourVector::PtEtaPhiM(pt1, eta1, phi1, m1);
+    FourVector fv2 = FourVector::PtEtaPhiM(pt2, eta2, phi2, m2);
+    TLorentzVector tlvSum = tlv1 + tlv2;
+    FourVector fvSum = fv1 + fv2;
+    maxDiffM = std::max(maxDiffM, std::fabs(fvSum.M() - tlvSum.M()) / tlvSum.M());
+    maxDiffPt = std::max(maxDiffPt, std::fabs(fvSum.Pt() - tlvSum.Pt()) / tlvSum.Pt());
+    maxDiffY = std::max(maxDiffY, std::fabs(fvSum.Rapidity() - tlvSum.Rapidity()) / std::max(1., std::fabs(tlvSum.Rapidity())));
+    maxDiffR = std::max(maxDiffR, std::fabs(fv1.DeltaR(fv2) - tlv1.DeltaR(tlv2)));
+
+    // PtEtaPhiE with the energy of the PtEtaPhiM vector (dressed truth leptons)
+    TLorentzVector tlvE;
+    tlvE.SetPtEtaPhiE(pt1, eta1, phi1, tlv1.E());
+    FourVector fvE = FourVector::PtEtaPhiE(pt1, eta1, phi1, tlv1.E());
+    maxDiffE = std::max(maxDiffE, std::fabs(fvE.pz - tlvE.Pz()) / tlvE.E());
+    maxDiffE = std::max(maxDiffE, std::fabs(fvE.Pt() - tlvE.Pt()) / tlvE.Pt());
+  }
+
+  if (maxDiffM < tolerance && maxDiffPt < tolerance && maxDiffY < tolerance && maxDiffR < tolerance && maxDiffE < tolerance)
+    return 0;
+  Error("ut_FourVector", "Max difference to TLorentzVector: mass %g, pt %g, rapidity %g, deltaR %g, PtEtaPhiE %g",
+      maxDiffM, maxDiffPt, maxDiffY, maxDiffR, maxDiffE);
+  return 1;
+}
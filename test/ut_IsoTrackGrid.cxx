@@ -0,0 +1,141 @@
+//
+//  Unit test of the eta-phi track grid of IsoTrackGrid.h: NumNeighbours must count
+//  the same tracks as a loop over all pairs with the dR < 0.4 definition of the
+//  isolated-track veto, including across the phi wrap at +-pi and for tracks on
+//  the cell edges.
+//
+//============================================================================================================
+
+#include <ZinvAnalysis/IsoTrackGrid.h>
+
+#include <TError.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+  struct Track {
+    float pt;
+    float eta;
+    float phi;
+  };
+
+  // Track phi is within [-pi, pi]
+  float wrapPhi(float phi) {
+    if (phi < -TMath::Pi()) phi += TMath::TwoPi();
+    if (phi > TMath::Pi()) phi -= TMath::TwoPi();
+    return phi;
+  }
+
+  // Loop over all tracks, same dR definition as IsoTrackGrid::NumNeighbours
+  int refNumNeighbours(const std::vector<Track>& tracks, float coneSize, float eta, float phi,
+      float ptMin, int skip) {
+    const float cone2 = coneSize * coneSize;
+    int nCloseby = 0;
+    for (unsigned int i = 0; i < tracks.size(); i++) {
+      if (int(i) == skip || tracks[i].pt < ptMin) continue;
+      const float dEta = tracks[i].eta - eta;
+      float dPhi = std::fabs(tracks[i].phi - phi);
+      if (dPhi > TMath::Pi()) dPhi = TMath::TwoPi() - dPhi;
+      if (dEta * dEta + dPhi * dPhi < cone2) nCloseby++;
+    }
+    return nCloseby;
+  }
+
+  // Compare the grid with the reference for every track as probe (skipping itself, as the
+  // veto does) and for the extra probes (counting all tracks), at several pt thresholds
+  bool check(IsoTrackGrid& grid, float coneSize, const std::vector<Track>& tracks,
+      const std::vector<Track>& probes, const char* name) {
+    grid.Clear();
+    for (const auto& track : tracks) grid.Add(track.pt, track.eta, track.phi);
+    grid.Build();
+
+    const float ptMins[] = {0., 1., 10.};
+    unsigned int nChecked = 0, nMismatches = 0;
+    for (float ptMin : ptMins) {
+      for (unsigned int i = 0; i < tracks.size(); i++) {
+        const int ref = refNumNeighbours(tracks, coneSize, tracks[i].eta, tracks[i].phi, ptMin, i);
+        const int num = grid.NumNeighbours(tracks[i].eta, tracks[i].phi, ptMin, i);
+        nChecked++;
+        if (num == ref) continue;
+        if (++nMismatches <= 5)
+          Error("ut_IsoTrackGrid", "%s: track at (%g, %g), pt > %g: %i neighbours, %i expected",
+              name, tracks[i].eta, tracks[i].phi, ptMin, num, ref);
+      }
+      for (const auto& probe : probes) {
+        const int ref = refNumNeighbours(tracks, coneSize, probe.eta, probe.phi, ptMin, -1);
+        const int num = grid.NumNeighbours(probe.eta, probe.phi, ptMin);
+        nChecked++;
+        if (num == ref) continue;
+        if (++nMismatches <= 5)
+          Error("ut_IsoTrackGrid", "%s: probe at (%g, %g), pt > %g: %i neighbours, %i expected",
+              name, probe.eta, probe.phi, ptMin, num, ref);
+      }
+    }
+
+    if (nMismatches == 0) return true;
+    Error("ut_IsoTrackGrid", "%s: %u of %u counts differ", name, nMismatches, nChecked);
+    return false;
+  }
+
+}
+
+int main() {
+
+  bool ok = true;
+  TRandom3 random(4357);
+  const float pi = TMath::Pi();
+
+  // Cone sizes of the veto (0.4) and ones leaving fewer than three phi cells
+  const float coneSizes[] = {0.4, 0.3, 2.5, 4.};
+  for (float coneSize : coneSizes) {
+    IsoTrackGrid grid(coneSize, 2.5);
+
+    // Random tracks within the grid, and some beyond |eta| = 2.5 in the edge cells
+    for (unsigned int n = 0; n <= 200; n += 25) {
+      std::vector<Track> tracks(n), probes(20);
+      for (auto& track : tracks) track = {float(random.Uniform(0.5, 20.)), float(random.Uniform(-2.7, 2.7)), float(random.Uniform(-pi, pi))};
+      for (auto& probe : probes) probe = {0., float(random.Uniform(-2.7, 2.7)), float(random.Uniform(-pi, pi))};
+      ok = check(grid, coneSize, tracks, probes, "random") && ok;
+    }
+
+    // Dense tracks close to the phi wrap, on both sides of +-pi and exactly at it
+    std::vector<Track> wrapTracks, wrapProbes;
+    for (unsigned int i = 0; i < 100; i++) {
+      const float phi = pi - float(random.Uniform(0., 0.5));
+      wrapTracks.push_back({float(random.Uniform(0.5, 20.)), float(random.Uniform(-1., 1.)), random.Rndm() < 0.5 ? phi : -phi});
+    }
+    wrapTracks.push_back({5., 0., pi});
+    wrapTracks.push_back({5., 0., -pi});
+    wrapTracks.push_back({5., 0.1, 3.14159f});
+    wrapTracks.push_back({5., 0.1, -3.14159f});
+    wrapProbes.push_back({0., 0., pi});
+    wrapProbes.push_back({0., 0., -pi});
+    wrapProbes.push_back({0., 0.5, pi - 0.2f});
+    wrapProbes.push_back({0., -0.5, -pi + 0.2f});
+    ok = check(grid, coneSize, wrapTracks, wrapProbes, "phi wrap") && ok;
+
+    // Tracks exactly on the cell edges and just inside the cone of them, every cell
+    const int nEta = int(2. * 2.5 / coneSize) < 1 ? 1 : int(2. * 2.5 / coneSize);
+    const int nPhi = int(TMath::TwoPi() / coneSize) < 1 ? 1 : int(TMath::TwoPi() / coneSize);
+    const float etaWidth = 2. * 2.5 / nEta;
+    const float phiWidth = TMath::TwoPi() / nPhi;
+    std::vector<Track> edgeTracks, edgeProbes;
+    for (int ie = 0; ie <= nEta; ie++) {
+      for (int ip = 0; ip <= nPhi; ip++) {
+        const float eta = -2.5 + ie * etaWidth;
+        const float phi = -pi + ip * phiWidth;
+        edgeTracks.push_back({float(random.Uniform(0.5, 20.)), eta, phi});
+        edgeTracks.push_back({float(random.Uniform(0.5, 20.)), eta + 0.99f * coneSize, phi});
+        edgeTracks.push_back({float(random.Uniform(0.5, 20.)), eta, wrapPhi(phi - 0.99f * coneSize)});
+        edgeProbes.push_back({0., eta - 0.5f * coneSize, wrapPhi(phi + 0.5f * coneSize)});
+      }
+    }
+    ok = check(grid, coneSize, edgeTracks, edgeProbes, "cell edges") && ok;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+#include <ZinvAnalysis/DeltaKernels.h>
+
+#include <TError.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TStopwatch.h>
+
+#include <cstdlib>
+#include <vector>
+
+// Time the scalar and batch pairwise deltaR over nObjects x nObjects pairs:
+// benchDeltaKernels [nObjects] [nRepeat]
+int main( int argc, char* argv[] ) {
+
+  unsigned int nObjects = 1000;
+  unsigned int nRepeat = 100;
+  if( argc > 1 ) nObjects = std::atoi( argv[ 1 ] );
+  if( argc > 2 ) nRepeat = std::atoi( argv[ 2 ] );
+
+  TRandom3 random(4357);
+  std::vector<float> eta(nObjects), phi(nObjects), dR(nObjects * nObjects);
+  for (unsigned int i = 0; i < nObjects; i++) {
+    eta[i] = random.Uniform(-4.5, 4.5);
+    phi[i] = random.Uniform(-TMath::Pi(), TMath::Pi());
+  }
+
+  TStopwatch timer;
+  float sum = 0.;
+  timer.Start();
+  for (unsigned int r = 0; r < nRepeat; r++) {
+    DeltaRPairwiseScalar(&eta[0], &phi[0], nObjects, &eta[0], &phi[0], nObjects, &dR[0]);
+    sum += dR[r % dR.size()];
+  }
+  timer.Stop();
+  double scalarTime = timer.RealTime();
+
+  timer.Start();
+  for (unsigned int r = 0; r < nRepeat; r++) {
+    DeltaRPairwise(&eta[0], &phi[0], nObjects, &eta[0], &phi[0], nObjects, &dR[0]);
+    sum += dR[r % dR.size()];
+  }
+  timer.Stop();
+  double batchTime = timer.RealTime();
+
+  Info("benchDeltaKernels", "Pairwise deltaR of %u x %u objects (x%u): scalar %.3f s, batch %.3f s (checksum %g)",
+      nObjects, nObjects, nRepeat, scalarTime, batchTime, sum);
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include <ZinvAnalysis/FourVector.h>
+
+#include <TError.h>
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TStopwatch.h>
+
+#include <cstdlib>
+#include <vector>
+
+// Time the jet pair mass with TLorentzVector and FourVector:
+// benchFourVector [nPairs] [nRepeat]
+int main( int argc, char* argv[] ) {
+
+  unsigned int nPairs = 100000;
+  unsigned int nRepeat = 100;
+  if( argc > 1 ) nPairs = std::atoi( argv[ 1 ] );
+  if( argc > 2 ) nRepeat = std::atoi( argv[ 2 ] );
+
+  TRandom3 random(4357);
+  std::vector<float> pt(2*nPairs), eta(2*nPairs), phi(2*nPairs), m(2*nPairs);
+  for (unsigned int i = 0; i < 2*nPairs; i++) {
+    pt[i] = random.Uniform(20000., 1000000.);
+    eta[i] = random.Uniform(-4.5, 4.5);
+    phi[i] = random.Uniform(-TMath::Pi(), TMath::Pi());
+    m[i] = random.Uniform(0., 50000.);
+  }
+
+  TStopwatch timer;
+  double sum = 0.;
+  timer.Start();
+  for (unsigned int r = 0; r < nRepeat; r++) {
+    for (unsigned int i = 0; i < nPairs; i++) {
+      TLorentzVector tlv1, tlv2;
+      tlv1.SetPtEtaPhiM(pt[2*i], eta[2*i], phi[2*i], m[2*i]);
+      tlv2.SetPtEtaPhiM(pt[2*i+1], eta[2*i+1], phi[2*i+1], m[2*i+1]);
+      sum += (tlv1 + tlv2).M();
+    }
+  }
+  timer.Stop();
+  double tlvTime = timer.RealTime();
+
+  timer.Start();
+  for (unsigned int r = 0; r < nRepeat; r++) {
+    for (unsigned int i = 0; i < nPairs; i++) {
+      sum += (FourVector::PtEtaPhiM(pt[2*i], eta[2*i], phi[2*i], m[2*i]) +
+          FourVector::PtEtaPhiM(pt[2*i+1], eta[2*i+1], phi[2*i+1], m[2*i+1])).M();
+    }
+  }
+  timer.Stop();
+  double fvTime = timer.RealTime();
+
+  Info("benchFourVector", "Pair mass of %u pairs (x%u): TLorentzVector %.3f s, FourVector %.3f s (checksum %g)",
+      nPairs, nRepeat, tlvTime, fvTime, sum);
+
+  return 0;
+}
@@ -6,6 +6,7 @@
 #include "EventLoop/DirectDriver.h"
 #include "SampleHandler/DiskListLocal.h"
 #include <TSystem.h>
+#include <cstdlib>
 #include "SampleHandler/ScanDir.h"
 #include <EventLoopAlgs/NTupleSvc.h>
 #include <EventLoop/OutputStream.h>
@@ -17,6 +18,14 @@ int main( int argc, char* argv[] ) {
   // Take the submit directory from the input if provided:
   std::string submitDir = "submitDir";
   if( argc > 1 ) submitDir = argv[ 1 ];
+  // Optional systematics slice, e.g. "localMCRun submitDir_3 3 32" for one of
+  // 32 parallel jobs; merge the slice outputs with hadd afterwards
+  int sysSliceIndex = 0;
+  int sysSliceCount = 1;
+  if( argc > 3 ) {
+    sysSliceIndex = atoi( argv[ 2 ] );
+    sysSliceCount = atoi( argv[ 3 ] );
+  }
 
   // Set up the job for xAOD access:
   xAOD::Init().ignore();
@@ -62,6 +71,8 @@ int main( int argc, char* argv[] ) {
 */
   // Add our analysis to the job:
   ZinvxAODAnalysis* alg = new ZinvxAODAnalysis();
+  alg->sysSliceIndex = sysSliceIndex;
+  alg->sysSliceCount = sysSliceCount;
   job.algsAdd( alg );
 /*
   // For ntuple